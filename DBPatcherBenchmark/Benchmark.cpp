@@ -0,0 +1,68 @@
+#include "Benchmark.h"
+
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <Windows.h>
+#include <Psapi.h>
+
+// Runs function several times and returns the best time in microseconds
+// The best run is the least affected by other processes and cold caches
+qint64 Benchmark::Measure(const std::function<void()> &function, int repeat_count)
+{
+	qint64 best_time = -1;
+
+	for (auto i = 0; i < repeat_count; ++i)
+	{
+		QElapsedTimer timer;
+		timer.start();
+		function();
+		const auto elapsed_time = timer.nsecsElapsed() / 1000;
+
+		if (best_time < 0 || elapsed_time < best_time)
+		{
+			best_time = elapsed_time;
+		}
+	}
+
+	return best_time;
+}
+
+// Returns private memory of the process in bytes
+qint64 Benchmark::MemoryUsage()
+{
+	PROCESS_MEMORY_COUNTERS_EX counters;
+
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&counters), sizeof(counters)))
+	{
+		return 0;
+	}
+
+	return counters.PrivateUsage;
+}
+
+// Prints title of benchmark group
+void Benchmark::WriteHeader(const QString &title)
+{
+	WriteLine("");
+	WriteLine(title);
+}
+
+// Prints time in milliseconds and memory in megabytes if it is measured
+void Benchmark::WriteResult(const QString &name, qint64 elapsed_time, qint64 memory)
+{
+	auto line = QString("  %1 %2 ms").arg(name, -44).arg(elapsed_time / 1000.0, 10, 'f', 2);
+
+	if (memory >= 0)
+	{
+		line += QString(" %1 MiB").arg(memory / 1048576.0, 10, 'f', 2);
+	}
+
+	WriteLine(line);
+}
+
+// Prints line to standard output
+void Benchmark::WriteLine(const QString &line)
+{
+	static QTextStream output(stdout);
+	output << line << endl;
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <QString>
+#include <functional>
+
+// Class with helpers shared by benchmarks
+// Results are printed to standard output as aligned lines, so runs before and after a change can be compared by diff
+class Benchmark
+{
+public:
+	Benchmark() = delete;
+	static qint64 Measure(const std::function<void()> &function, int repeat_count = 5);
+	static qint64 MemoryUsage();
+	static void WriteHeader(const QString &title);
+	static void WriteResult(const QString &name, qint64 elapsed_time, qint64 memory = -1);
+	static void WriteLine(const QString &line);
+};
\ No newline at end of file
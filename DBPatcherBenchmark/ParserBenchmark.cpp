@@ -0,0 +1,238 @@
+#include "ParserBenchmark.h"
+#include "Benchmark.h"
+#include "ListFileParser.h"
+#include "ObjectTypes.h"
+
+#include <QFile>
+#include <QRegExp>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+namespace
+{
+	// Previous object list parser: regular expressions are built and matched for every line, then the line is split again
+	PatchList LegacyParseObjectList(const QString &path, bool &is_successful)
+	{
+		QFile file(path);
+
+		if (!file.open(QIODevice::ReadOnly))
+		{
+			is_successful = false;
+			return PatchList();
+		}
+
+		QTextStream input(&file);
+		PatchList object_list;
+
+		while (!input.atEnd())
+		{
+			const QString read_string = input.readLine();
+
+			if (QRegExp("( )*").exactMatch(read_string))
+			{
+				continue;
+			}
+
+			int type = ObjectTypes::type_count;
+			QString schema_name = "";
+			QString name;
+			QStringList parameters = QStringList("");
+
+			if (QRegExp("([^ ])+ ([^ ])+ (table|sequence|view|trigger|index)( )*").exactMatch(read_string))
+			{
+				const auto split_result = read_string.split(" ", QString::SkipEmptyParts);
+				schema_name = split_result.at(0);
+				name = split_result.at(1);
+				type = ObjectTypes::type_names.key(split_result.at(2));
+			}
+			else if (QRegExp("script ([^ ])+( )*").exactMatch(read_string))
+			{
+				const auto split_result = read_string.split(" ", QString::SkipEmptyParts);
+				name = split_result.at(1);
+				type = ObjectTypes::script;
+			}
+			else if (QRegExp("([^ ])+ ([^ ])+ function \\( (([^,() ])+ )*\\)( )*").exactMatch(read_string))
+			{
+				auto split_result = read_string.split(QRegExp("(\\ |\\(|\\))"), QString::SkipEmptyParts);
+				schema_name = split_result.first();
+				split_result.pop_front();
+				name = split_result.first();
+				split_result.pop_front();
+				type = ObjectTypes::function;
+				split_result.pop_front();
+
+				if (!split_result.isEmpty())
+				{
+					parameters = split_result;
+				}
+			}
+			else
+			{
+				is_successful = false;
+				return PatchList();
+			}
+
+			object_list.Add(type, schema_name, name, parameters);
+		}
+
+		is_successful = true;
+		return object_list;
+	}
+
+	// Previous dependency list parser
+	PatchList LegacyParseDependencyList(const QString &path, bool &is_successful)
+	{
+		QFile file(path);
+
+		if (!file.open(QIODevice::ReadOnly))
+		{
+			is_successful = false;
+			return PatchList();
+		}
+
+		QTextStream input(&file);
+		PatchList dependency_list;
+
+		while (!input.atEnd())
+		{
+			const QString read_string = input.readLine();
+
+			if (QRegExp("( )*").exactMatch(read_string))
+			{
+				continue;
+			}
+
+			if (!QRegExp("([^ ])+ ([^ ])+ (table|sequence|view|trigger|index|function)( )*").exactMatch(read_string))
+			{
+				is_successful = false;
+				return PatchList();
+			}
+
+			const auto split_result = read_string.split(" ", QString::SkipEmptyParts);
+			dependency_list.Add(ObjectTypes::type_names.key(split_result.at(2)), split_result.at(0), split_result.at(1), QStringList());
+		}
+
+		is_successful = true;
+		return dependency_list;
+	}
+}
+
+const int ParserBenchmark::object_line_count = 200000;
+const int ParserBenchmark::dependency_line_count = 500000;
+
+// Runs benchmark and prints its results
+// Both parsers must accept generated files and give the same amount of objects, otherwise the timing is not printed
+void ParserBenchmark::Run()
+{
+	Benchmark::WriteHeader(QString("List parsers, %1 object lines, %2 dependency lines").arg(object_line_count).arg(dependency_line_count));
+
+	QTemporaryDir directory;
+	const auto object_list_path = directory.filePath("ObjectList.txt");
+	const auto dependency_list_path = directory.filePath("DependencyList.txt");
+
+	if (!directory.isValid() || !WriteObjectList(object_list_path) || !WriteDependencyList(dependency_list_path))
+	{
+		Benchmark::WriteLine("  Test files are not written");
+		return;
+	}
+
+	const auto measure = [](const QString &name, const std::function<PatchList(bool&)> &parse, int expected_count)
+	{
+		auto is_successful = false;
+		auto count = 0;
+		const auto elapsed_time = Benchmark::Measure([&]()
+		{
+			count = parse(is_successful).Count();
+		}, 3);
+
+		if (!is_successful || count != expected_count)
+		{
+			Benchmark::WriteLine(QString("  %1 failed: %2 of %3 objects").arg(name).arg(count).arg(expected_count));
+			return;
+		}
+
+		Benchmark::WriteResult(name, elapsed_time);
+	};
+
+	measure("Regular expressions: object list", [&](bool &is_successful)
+	{
+		return LegacyParseObjectList(object_list_path, is_successful);
+	}, object_line_count);
+	measure("ListFileParser: object list", [&](bool &is_successful)
+	{
+		return ListFileParser(ListFileParser::object_list_format).Parse(object_list_path, is_successful);
+	}, object_line_count);
+	measure("Regular expressions: dependency list", [&](bool &is_successful)
+	{
+		return LegacyParseDependencyList(dependency_list_path, is_successful);
+	}, dependency_line_count);
+	measure("ListFileParser: dependency list", [&](bool &is_successful)
+	{
+		return ListFileParser(ListFileParser::dependency_list_format).Parse(dependency_list_path, is_successful);
+	}, dependency_line_count);
+}
+
+// Writes object list with tables, views, functions with parameters and scripts
+bool ParserBenchmark::WriteObjectList(const QString &path)
+{
+	QFile file(path);
+
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		return false;
+	}
+
+	QTextStream output(&file);
+
+	for (auto i = 0; i < object_line_count; ++i)
+	{
+		switch (i % 4)
+		{
+			case 0:
+			{
+				output << "schema_" << i % 50 << " function_" << i << " function ( integer text ) \n";
+				break;
+			}
+			case 1:
+			{
+				output << "script C:/patch/scripts/script_" << i << ".sql\n";
+				break;
+			}
+			case 2:
+			{
+				output << "schema_" << i % 50 << " view_" << i << " view\n";
+				break;
+			}
+			default:
+			{
+				output << "schema_" << i % 50 << " table_" << i << " table\n";
+				break;
+			}
+		}
+	}
+
+	output.flush();
+	return output.status() == QTextStream::Ok;
+}
+
+// Writes dependency list with tables, sequences and functions
+bool ParserBenchmark::WriteDependencyList(const QString &path)
+{
+	QFile file(path);
+
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		return false;
+	}
+
+	QTextStream output(&file);
+
+	for (auto i = 0; i < dependency_line_count; ++i)
+	{
+		const auto type = i % 3 == 0 ? "function" : i % 3 == 1 ? "sequence" : "table";
+		output << "schema_" << i % 50 << " dependency_" << i << " " << type << "\n";
+	}
+
+	output.flush();
+	return output.status() == QTextStream::Ok;
+}
\ No newline at end of file
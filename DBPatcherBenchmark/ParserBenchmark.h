@@ -0,0 +1,18 @@
+#pragma once
+
+#include <QString>
+
+// Class comparing ListFileParser with the regular expression parser it replaced
+// Object and dependency lists are generated in a temporary directory and parsed by both parsers
+class ParserBenchmark
+{
+public:
+	ParserBenchmark() = delete;
+	static void Run();
+private:
+	// Amount of lines in generated object and dependency lists
+	static const int object_line_count;
+	static const int dependency_line_count;
+	static bool WriteObjectList(const QString &path);
+	static bool WriteDependencyList(const QString &path);
+};
\ No newline at end of file
@@ -0,0 +1,178 @@
+#include "PatchListBenchmark.h"
+#include "Benchmark.h"
+#include "PatchList.h"
+#include "PatchListElement.h"
+#include "ObjectTypes.h"
+
+#include <QList>
+#include <QStringList>
+#include <QVector>
+#include <memory>
+
+namespace
+{
+	// Object of the previous list layout, every one allocated separately with its own strings
+	struct LegacyElement
+	{
+		int type;
+		QString name;
+		QString schema;
+		QStringList parameters;
+	};
+
+	// Previous list layout: heap-allocated list of heap-allocated elements, copied element by element
+	class LegacyPatchList
+	{
+	public:
+		LegacyPatchList() = default;
+
+		LegacyPatchList(const LegacyPatchList &other)
+		{
+			for (const auto current : other.elements)
+			{
+				elements.append(new LegacyElement(*current));
+			}
+		}
+
+		~LegacyPatchList()
+		{
+			qDeleteAll(elements);
+		}
+
+		void Add(int type, const QString &schema, const QString &name, const QStringList &parameters)
+		{
+			elements.append(new LegacyElement({ type, name, schema, parameters }));
+		}
+
+		// Elements of the list
+		QList<LegacyElement*> elements;
+	};
+
+	// Object generated for lists
+	struct GeneratedObject
+	{
+		int type;
+		QString schema;
+		QString name;
+		QStringList parameters;
+	};
+
+	// Returns deep copy of string, as strings read from a list file share no data with each other
+	QString Detached(const QString &value)
+	{
+		return QString(value.constData(), value.size());
+	}
+
+	// Adds generated object to legacy list with its own copies of strings
+	void AddDetached(LegacyPatchList &list, const GeneratedObject &object)
+	{
+		QStringList parameters;
+
+		for (const auto &current : object.parameters)
+		{
+			parameters.append(Detached(current));
+		}
+
+		list.Add(object.type, Detached(object.schema), Detached(object.name), parameters);
+	}
+
+	// Returns object by index with a realistic mix of types, 50 schemas and 2 parameters of every function
+	GeneratedObject Generate(int index)
+	{
+		const auto type = index % 5 == 0 ? ObjectTypes::function : index % 3 == 0 ? ObjectTypes::view : ObjectTypes::table;
+		const auto schema = QString("schema_%1").arg(index % 50);
+		const auto name = QString("object_name_%1").arg(index);
+		const auto parameters = type == ObjectTypes::function ? QStringList({ "parameter_id", "parameter_value" }) : QStringList();
+		return { type, schema, name, parameters };
+	}
+}
+
+const int PatchListBenchmark::element_count = 100000;
+
+// Runs benchmark and prints its results
+void PatchListBenchmark::Run()
+{
+	Benchmark::WriteHeader(QString("PatchList, %1 objects").arg(element_count));
+
+	QVector<GeneratedObject> source;
+	source.reserve(element_count);
+
+	for (auto i = 0; i < element_count; ++i)
+	{
+		source.append(Generate(i));
+	}
+
+	// Memory is measured for a list kept alive, time is the best of several builds
+	{
+		const auto memory_before = Benchmark::MemoryUsage();
+		std::unique_ptr<LegacyPatchList> kept_list(new LegacyPatchList);
+
+		for (const auto &current : source)
+		{
+			AddDetached(*kept_list, current);
+		}
+
+		const auto memory = Benchmark::MemoryUsage() - memory_before;
+		const auto build_time = Benchmark::Measure([&]()
+		{
+			LegacyPatchList list;
+
+			for (const auto &current : source)
+			{
+				AddDetached(list, current);
+			}
+		});
+
+		Benchmark::WriteResult("Heap elements: build", build_time, memory);
+		Benchmark::WriteResult("Heap elements: copy", Benchmark::Measure([&]()
+		{
+			LegacyPatchList copy(*kept_list);
+		}));
+
+		auto total_size = 0;
+		Benchmark::WriteResult("Heap elements: iterate", Benchmark::Measure([&]()
+		{
+			for (const auto current : kept_list->elements)
+			{
+				total_size += current->name.size() + current->schema.size() + current->type;
+			}
+		}));
+	}
+
+	{
+		const auto memory_before = Benchmark::MemoryUsage();
+		PatchList kept_list;
+
+		for (const auto &current : source)
+		{
+			kept_list.Add(current.type, current.schema, current.name, current.parameters);
+		}
+
+		const auto memory = Benchmark::MemoryUsage() - memory_before;
+		const auto build_time = Benchmark::Measure([&]()
+		{
+			PatchList list;
+
+			for (const auto &current : source)
+			{
+				list.Add(current.type, current.schema, current.name, current.parameters);
+			}
+		});
+
+		Benchmark::WriteResult("PatchList: build", build_time, memory);
+		Benchmark::WriteResult("PatchList: copy and detach", Benchmark::Measure([&]()
+		{
+			auto copy = kept_list;
+			copy.Add(ObjectTypes::table, "public", "detached");
+		}));
+
+		auto total_size = 0;
+		Benchmark::WriteResult("PatchList: iterate", Benchmark::Measure([&]()
+		{
+			for (const auto current : kept_list)
+			{
+				total_size += current.GetName().size() + current.GetSchema().size() + current.GetType();
+			}
+		}));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+// Class comparing PatchList with the list of heap-allocated elements it replaced
+// Measures time and memory of building, copying and iterating a 100k-element list
+class PatchListBenchmark
+{
+public:
+	PatchListBenchmark() = delete;
+	static void Run();
+private:
+	// Amount of objects in measured lists
+	static const int element_count;
+};
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "WriterBenchmark.h"
+#include "Benchmark.h"
+#include "ListFileWriter.h"
+#include "ObjectTypes.h"
+#include "PatchList.h"
+#include "PatchListElement.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+const int WriterBenchmark::line_count = 1000000;
+
+// Runs benchmark and prints its results
+// Files of both writers must have the same size, otherwise the timing is not printed
+void WriterBenchmark::Run()
+{
+	Benchmark::WriteHeader(QString("List writers, %1 dependency lines").arg(line_count));
+
+	QTemporaryDir directory;
+
+	if (!directory.isValid())
+	{
+		Benchmark::WriteLine("  Temporary directory is not created");
+		return;
+	}
+
+	PatchList dependency_list;
+	dependency_list.Reserve(line_count);
+
+	for (auto i = 0; i < line_count; ++i)
+	{
+		const auto type = i % 3 == 0 ? ObjectTypes::function : i % 3 == 1 ? ObjectTypes::sequence : ObjectTypes::table;
+		dependency_list.Add(type, QString("schema_%1").arg(i % 50), QString("dependency_%1").arg(i));
+	}
+
+	const auto legacy_path = directory.filePath("LegacyDependencyList.txt");
+	const auto path = directory.filePath("DependencyList.txt");
+	auto is_legacy_successful = true;
+	auto is_successful = true;
+	const auto legacy_time = Benchmark::Measure([&]()
+	{
+		is_legacy_successful = LegacyWrite(legacy_path, dependency_list) && is_legacy_successful;
+	}, 3);
+	const auto elapsed_time = Benchmark::Measure([&]()
+	{
+		is_successful = Write(path, dependency_list) && is_successful;
+	}, 3);
+
+	if (!is_legacy_successful || !is_successful || QFileInfo(legacy_path).size() != QFileInfo(path).size())
+	{
+		Benchmark::WriteLine("  Written files differ or are not written");
+		return;
+	}
+
+	Benchmark::WriteResult("QTextStream with endl", legacy_time);
+	Benchmark::WriteResult("ListFileWriter", elapsed_time);
+}
+
+// Writes list as it was done before: every line is flushed by endl, temporary file replaces the target
+bool WriterBenchmark::LegacyWrite(const QString &path, const PatchList &dependency_list)
+{
+	QFile temp_file(QFileInfo(path).absoluteDir().absoluteFilePath("temp.dpn"));
+
+	if (!temp_file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::NewOnly))
+	{
+		return false;
+	}
+
+	QTextStream dependency_file_stream(&temp_file);
+
+	for (const auto current : dependency_list)
+	{
+		dependency_file_stream << current.GetSchema() << " " << current.GetName() << " "
+			<< ObjectTypes::type_names.value(current.GetType()) << endl;
+	}
+
+	temp_file.close();
+	QFile::remove(path);
+	return temp_file.rename(path);
+}
+
+// Writes list as FileHandler::MakeDependencyList does it
+bool WriterBenchmark::Write(const QString &path, const PatchList &dependency_list)
+{
+	ListFileWriter writer(path);
+
+	if (!writer.Open())
+	{
+		return false;
+	}
+
+	for (const auto current : dependency_list)
+	{
+		writer.Write(current.GetSchema());
+		writer.Write(' ');
+		writer.Write(current.GetName());
+		writer.Write(' ');
+		writer.Write(ObjectTypes::type_names.value(current.GetType()));
+		writer.EndLine();
+	}
+
+	return writer.Commit();
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <QString>
+
+class PatchList;
+
+// Class comparing ListFileWriter with the QTextStream writing it replaced
+// Dependency list of 1M lines is written into a temporary directory by both writers
+class WriterBenchmark
+{
+public:
+	WriterBenchmark() = delete;
+	static void Run();
+private:
+	// Amount of lines in written dependency list
+	static const int line_count;
+	static bool LegacyWrite(const QString &path, const PatchList &dependency_list);
+	static bool Write(const QString &path, const PatchList &dependency_list);
+};
\ No newline at end of file
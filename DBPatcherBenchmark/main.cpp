@@ -0,0 +1,17 @@
+#include "Benchmark.h"
+#include "ParserBenchmark.h"
+#include "PatchListBenchmark.h"
+#include "WriterBenchmark.h"
+
+#include <QCoreApplication>
+
+// Runs all benchmarks, Release build is expected, as Debug one measures Qt assertions
+int main(int argc, char *argv[])
+{
+	QCoreApplication application(argc, argv);
+	Benchmark::WriteLine("DBPatcher benchmarks");
+	PatchListBenchmark::Run();
+	ParserBenchmark::Run();
+	WriterBenchmark::Run();
+	return 0;
+}
\ No newline at end of file
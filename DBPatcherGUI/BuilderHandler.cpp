@@ -1,7 +1,8 @@
 #include "BuilderHandler.h"
+#include "ProcessJob.h"
 
-#include <QProcess>
 #include <QIODevice>
+#include <QTextCodec>
 
 const QString BuilderHandler::program = "PatchBuilder_exe.exe";
 QString BuilderHandler::templates_path = "Templates.ini";
@@ -13,48 +14,38 @@ void BuilderHandler::SetOutputDevice(QIODevice &new_device)
 	output_device = &new_device;
 }
 
+// Writes message to log device in the encoding of module output
+void BuilderHandler::WriteLog(const QString &message)
+{
+	static const auto codec = QTextCodec::codecForName("Windows-1251");
+
+	if (output_device)
+	{
+		output_device->write(codec ? codec->fromUnicode(message + '\n') : (message + '\n').toLocal8Bit());
+	}
+}
+
 void BuilderHandler::SetTemplatesFile(const QString &path)
 {
 	templates_path = path;
 }
 
-// Launches and manages Builder process
-// Returns result of patch build
-bool BuilderHandler::BuildPatch(const QString& database, const QString& user, const QString& password
-	, const QString& server, int port, const QString &patch_dir, const QString &build_list_dir)
+// Makes job running Builder process, its output is written to log device
+// Job is not started, so the caller connects to its signals first
+ProcessJob* BuilderHandler::BuildPatch(const QString& database, const QString& user, const QString& password
+	, const QString& server, int port, const QString &patch_dir, const QString &build_list_dir, QObject *parent)
 {
 	const auto connection_info = QString("%1:%2:%3:%4:%5").arg(server).arg(port).arg(database).arg(user).arg(password);
 	const QStringList arguments = { "-d", patch_dir, "-p", build_list_dir, "-c", connection_info, "-t", templates_path };
+	const auto job = new ProcessJob(program, arguments, parent);
 
-	QProcess builder_process;
-
-	connect(&builder_process, &QProcess::readyReadStandardOutput, [&builder_process]()
-	{
-		if (output_device)
-		{
-			output_device->write(builder_process.readAllStandardOutput());
-		}
-	});
-
-	connect(&builder_process, &QProcess::readyReadStandardError, [&builder_process]()
+	connect(job, &ProcessJob::OutputReceived, [](const QByteArray &output)
 	{
 		if (output_device)
 		{
-			output_device->write(builder_process.readAllStandardError());
+			output_device->write(output);
 		}
 	});
 
-	builder_process.start(program, arguments);
-
-	if (!builder_process.waitForStarted())
-	{
-		return false;
-	}
-
-	if (!builder_process.waitForFinished() || builder_process.exitCode() != 0)
-	{
-		return false;
-	}
-
-	return true;
+	return job;
 }
\ No newline at end of file
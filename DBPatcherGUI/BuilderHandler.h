@@ -4,7 +4,7 @@
 
 class QString;
 class QIODevice;
-class QProcess;
+class ProcessJob;
 
 // Class for Builder module process management
 class BuilderHandler : public QObject
@@ -14,8 +14,9 @@ class BuilderHandler : public QObject
 public:
 	BuilderHandler() = delete;
 	static void SetOutputDevice(QIODevice &new_device);
-	static bool BuildPatch(const QString &database, const QString &user, const QString &password,
-		const QString &server, int port, const QString &patch_dir, const QString &build_list_dir);
+	static void WriteLog(const QString &message);
+	static ProcessJob* BuildPatch(const QString &database, const QString &user, const QString &password,
+		const QString &server, int port, const QString &patch_dir, const QString &build_list_dir, QObject *parent);
 	static void SetTemplatesFile(const QString &path);
 private:
 	// Name of Builder module program file
@@ -2,25 +2,41 @@
 #include "ui_BuilderWidget.h"
 #include "PatchListWidget.h"
 #include "PatchList.h"
+#include "PatchListElement.h"
 #include "DatabaseProvider.h"
 #include "ObjectTypes.h"
 #include "BuilderHandler.h"
 #include "ObjectNameCompleter.h"
 #include "FileHandler.h"
+#include "CatalogCache.h"
+#include "ProcessJob.h"
+#include "FunctionTask.h"
 
 #include <QFileDialog>
 #include <QMessageBox>
-#include <QSqlQueryModel>
+#include <QStringListModel>
+#include <QBitArray>
+#include <QTimer>
+#include <QMenu>
+#include <QClipboard>
+#include <QSet>
+#include <QThreadPool>
+
+const int BuilderWidget::completer_delay = 250;
 
 // Widget constructor, taking pointer to parent widget
 // When parent widget is being deleted, all its children are deleted automatically
 BuilderWidget::BuilderWidget(QWidget *parent)
 	: QWidget(parent)
 	, ui(new Ui::BuilderWidget)
-	, schema_list_model(new QSqlQueryModel(this))
+	, schema_list_model(new QStringListModel(this))
 	, name_completer(new ObjectNameCompleter(this))
+	, completer_timer(new QTimer(this))
+	, build_job(nullptr)
 {
 	ui->setupUi(this);
+	completer_timer->setSingleShot(true);
+	completer_timer->setInterval(completer_delay);
 
 	// Initialization of ui elements
 	ui->schema_combo_box->setModel(schema_list_model);
@@ -40,6 +56,11 @@ BuilderWidget::BuilderWidget(QWidget *parent)
 	ui->type_combo_box->addItem(QIcon(":/images/index.svg"), "index", ObjectTypes::index);
 
 	InitScriptInput();
+
+	const auto import_menu = new QMenu(this);
+	import_menu->addAction("From file...", this, &BuilderWidget::OnImportFileTriggered);
+	import_menu->addAction("From clipboard", this, &BuilderWidget::OnImportClipboardTriggered);
+	ui->import_button->setMenu(import_menu);
  
 	connect(ui->name_edit, &QLineEdit::returnPressed, [=]()
 	{
@@ -52,13 +73,19 @@ BuilderWidget::BuilderWidget(QWidget *parent)
 	connect(ui->add_button, &QPushButton::clicked, this, &BuilderWidget::OnAddButtonClicked);
 	connect(ui->build_button, &QPushButton::clicked, this, &BuilderWidget::OnBuildButtonClicked);
 	connect(ui->remove_button, &QPushButton::clicked, this, &BuilderWidget::OnRemoveButtonClicked);
-	connect(ui->build_list_widget, &PatchListWidget::itemSelectionChanged, this, &BuilderWidget::OnItemSelectionChanged);
+	connect(ui->build_list_widget, &PatchListWidget::SelectionChanged, this, &BuilderWidget::OnItemSelectionChanged);
 	connect(ui->type_combo_box, SIGNAL(currentIndexChanged(int)), this, SLOT(OnCurrentTypeChanged(int)));
 	connect(ui->move_up_button, &QPushButton::clicked, this, &BuilderWidget::OnMoveUpButtonClicked);
 	connect(ui->move_down_button, &QPushButton::clicked, this, &BuilderWidget::OnMoveDownButtonClicked);
 	connect(ui->clear_button, &QPushButton::clicked, this, &BuilderWidget::OnClearButtonClicked);
 	connect(ui->explorer_button, &QPushButton::clicked, this, &BuilderWidget::OnExplorerButtonClicked);
 	connect(ui->name_edit, SIGNAL(textChanged(const QString&)), this, SLOT(OnNameTextChanged(const QString&)));
+	connect(ui->name_edit, &QLineEdit::textEdited, name_completer, &ObjectNameCompleter::Search);
+	connect(ui->all_schemas_check_box, &QCheckBox::toggled, this, &BuilderWidget::OnAllSchemasToggled);
+	connect(name_completer, &ObjectNameCompleter::SchemaAccepted, this, &BuilderWidget::OnCompletionSchemaAccepted);
+	connect(name_completer, &ObjectNameCompleter::Fetched, this, &BuilderWidget::OnCompleterFetched);
+	connect(name_completer, &ObjectNameCompleter::FetchFailed, this, &BuilderWidget::OnCompleterFetchFailed);
+	connect(completer_timer, &QTimer::timeout, this, &BuilderWidget::InitCompleter);
 	connect(this, &BuilderWidget::ItemCountChanged, &BuilderWidget::OnItemCountChanged);
 	connect(ui->schema_combo_box, SIGNAL(currentTextChanged(const QString&)), this, SLOT(OnCurrentSchemaChanged(const QString&)));
 }
@@ -88,7 +115,7 @@ bool BuilderWidget::CheckConnection()
 // Checks the availability of new element addition and calls add methods
 void BuilderWidget::OnAddButtonClicked()
 {
-	if (!CheckConnection())
+	if (!CheckConnection() || !ui->add_button->isEnabled())
 	{
 		return;
 	}
@@ -121,56 +148,44 @@ void BuilderWidget::OnAddButtonClicked()
 		return;
 	}
 
-	auto exists = false;
+	const auto type_name = ui->type_combo_box->currentText().replace(0, 1, ui->type_combo_box->currentText()[0].toUpper());
+	PatchList check_list;
+	check_list.Add(type_index, schema, name_input);
 
-	switch (ui->type_combo_box->currentData(Qt::UserRole).toInt())
+	// Existence check may go to the database, so the button is locked until its result arrives
+	ui->add_button->setDisabled(true);
+	DatabaseProvider::CheckExistence(check_list, this, [=](const QBitArray &exists, const QString &error_message)
 	{
-		case ObjectTypes::table:
-		{
-			exists = DatabaseProvider::TableExists(schema, name_input);
-			break;
-		}
-		case ObjectTypes::sequence:
-		{
-			exists = DatabaseProvider::SequenceExists(schema, name_input);
-			break;
-		}
-		case ObjectTypes::view:
+		ui->add_button->setEnabled(true);
+
+		if (!error_message.isEmpty())
 		{
-			exists = DatabaseProvider::ViewExists(schema, name_input);
-			break;
+			QApplication::beep();
+			QMessageBox::warning(this, "Item not added"
+				, "Existence check failed: " + error_message
+				, QMessageBox::Ok, QMessageBox::Ok);
+			return;
 		}
-		case ObjectTypes::trigger:
+
+		if (ui->build_list_widget->ItemExists(type_index, schema, name_input))
 		{
-			exists = DatabaseProvider::TriggerExists(schema, name_input);
-			break;
+			return;
 		}
-		case ObjectTypes::function:
+
+		if (exists.testBit(0))
 		{
-			exists = DatabaseProvider::FunctionExists(schema, name_input);
-			break;
+			ui->build_list_widget->Add(type_index, schema, name_input, true);
+			ui->name_edit->clear();
+			emit ItemCountChanged();
 		}
-		case ObjectTypes::index:
+		else
 		{
-			exists = DatabaseProvider::IndexExists(schema, name_input);
-			break;
+			QApplication::beep();
+			QMessageBox::warning(this, "Item not added"
+				, type_name + " " + name_input + " does not exist in current schema"
+				, QMessageBox::Ok, QMessageBox::Ok);
 		}
-	}
-
-	if (exists)
-	{
-		ui->build_list_widget->Add(type_index, schema, name_input, true);
-		ui->name_edit->clear();
-		emit ItemCountChanged();
-	}
-	else
-	{
-		QApplication::beep();
-		QMessageBox::warning(this, "Item not added"
-			, ui->type_combo_box->currentText().replace(0, 1, ui->type_combo_box->currentText()[0].toUpper())
-				+ " " + name_input + " does not exist in current schema"
-			, QMessageBox::Ok, QMessageBox::Ok);
-	}
+	});
 }
 
 // Parses script names string if it is not empty, or opens file dialog otherwise
@@ -231,10 +246,158 @@ void BuilderWidget::AddScripts(const QString &input)
 	emit ItemCountChanged();
 }
 
+// Handles import from file action
+// Imports objects from patch list or CSV file chosen by user
+void BuilderWidget::OnImportFileTriggered()
+{
+	if (!CheckConnection())
+	{
+		return;
+	}
+
+	const auto path_input = QFileDialog::getOpenFileName(this, "Import objects", "", "Patch Lists (*.txt *.csv);;All Files (*)");
+
+	if (path_input.isEmpty())
+	{
+		return;
+	}
+
+	QStringList rejected_lines;
+	auto is_successful = false;
+	const auto objects = FileHandler::ParseImportFile(path_input, rejected_lines, is_successful);
+
+	if (!is_successful)
+	{
+		QApplication::beep();
+		QMessageBox::warning(this, "Import error", "File " + path_input + " cannot be opened"
+			, QMessageBox::Ok, QMessageBox::Ok);
+		return;
+	}
+
+	ImportObjects(objects, rejected_lines);
+}
+
+// Handles import from clipboard action
+// Imports objects from text copied to clipboard
+void BuilderWidget::OnImportClipboardTriggered()
+{
+	if (!CheckConnection())
+	{
+		return;
+	}
+
+	QStringList rejected_lines;
+	const auto objects = FileHandler::ParseImportText(QApplication::clipboard()->text(), rejected_lines);
+	ImportObjects(objects, rejected_lines);
+}
+
+// Validates imported objects and adds valid ones to the patch list keeping their order
+// Scripts are checked in file system, database objects are checked with one batched lookup
+// Rejected objects are listed in a single report when all objects are checked
+void BuilderWidget::ImportObjects(const PatchList &objects, const QStringList &rejected_lines)
+{
+	const auto describe = [](int type_index, const QString &schema, const QString &name)
+	{
+		return ObjectTypes::type_names.value(type_index) + " " + (schema.isEmpty() ? name : schema + "." + name);
+	};
+
+	auto rejected = rejected_lines;
+	PatchList candidates;
+	PatchList check_list;
+	// Index of every candidate in check list, -1 for scripts which are already checked
+	QList<int> check_indexes;
+	QSet<CatalogObject> imported_objects;
+
+	for (const auto current : objects)
+	{
+		const CatalogObject object = { current.GetType(), current.GetSchema(), current.GetName() };
+
+		if (imported_objects.contains(object) || ui->build_list_widget->ItemExists(object.type, object.schema, object.name))
+		{
+			rejected.append(describe(object.type, object.schema, object.name) + ": already exists in patch list");
+			continue;
+		}
+
+		imported_objects.insert(object);
+
+		if (object.type == ObjectTypes::script)
+		{
+			const QFileInfo file_info(object.name);
+
+			if (!file_info.exists() || file_info.suffix() != "sql")
+			{
+				rejected.append(describe(object.type, object.schema, object.name) + ": not found or not a SQL-script (*.sql)");
+				continue;
+			}
+
+			check_indexes.append(-1);
+		}
+		else
+		{
+			check_indexes.append(check_list.Count());
+			check_list.Add(object.type, object.schema, object.name);
+		}
+
+		candidates.Add(object.type, object.schema, object.name);
+	}
+
+	ui->import_button->setDisabled(true);
+	DatabaseProvider::CheckExistence(check_list, this, [=](const QBitArray &exists, const QString &error_message) mutable
+	{
+		ui->import_button->setEnabled(true);
+
+		// Failed query leaves existence unknown, so nothing is imported rather than rejected as missing
+		if (!error_message.isEmpty())
+		{
+			QApplication::beep();
+			QMessageBox::warning(this, "Import error"
+				, "Existence check failed, no objects are imported: " + error_message
+				, QMessageBox::Ok, QMessageBox::Ok);
+			return;
+		}
+		PatchList valid_list;
+		auto position = 0;
+
+		for (const auto current : candidates)
+		{
+			const auto check_index = check_indexes.at(position++);
+
+			if (check_index != -1 && !exists.testBit(check_index))
+			{
+				rejected.append(describe(current.GetType(), current.GetSchema(), current.GetName()) + ": does not exist in database");
+			}
+			else if (ui->build_list_widget->ItemExists(current.GetType(), current.GetSchema(), current.GetName()))
+			{
+				rejected.append(describe(current.GetType(), current.GetSchema(), current.GetName()) + ": already exists in patch list");
+			}
+			else
+			{
+				valid_list.Add(current.GetType(), current.GetSchema(), current.GetName());
+			}
+		}
+
+		ui->build_list_widget->Add(valid_list, true);
+		emit ItemCountChanged();
+
+		QMessageBox report(rejected.isEmpty() ? QMessageBox::Information : QMessageBox::Warning, "Import completed"
+			, QString("Objects added: %1. Objects rejected: %2").arg(valid_list.Count()).arg(rejected.count())
+			, QMessageBox::Ok, this);
+
+		if (!rejected.isEmpty())
+		{
+			QApplication::beep();
+			report.setDetailedText(rejected.join("\n"));
+		}
+
+		report.exec();
+	});
+}
+
 // Initializes ui elements for script path input
 void BuilderWidget::InitScriptInput()
 {
 	ui->schema_combo_box->setDisabled(true);
+	ui->all_schemas_check_box->setDisabled(true);
 	ui->name_edit->setPlaceholderText("SQL script file path (leave empty to open in explorer)");
 	ui->name_label->setText("Path");
 }
@@ -242,6 +405,8 @@ void BuilderWidget::InitScriptInput()
 // Updates name completer from database by schema name and type index 
 void BuilderWidget::InitCompleter()
 {
+	completer_timer->stop();
+
 	if (!DatabaseProvider::IsConnected())
 	{
 		return;
@@ -254,10 +419,26 @@ void BuilderWidget::InitCompleter()
 		return;
 	}
 
-	name_completer->Fetch(ui->type_combo_box->currentData(Qt::UserRole).toInt(), ui->schema_combo_box->currentText());
+	if (ui->all_schemas_check_box->isChecked())
+	{
+		name_completer->FetchAllSchemas(ui->type_combo_box->currentData(Qt::UserRole).toInt());
+	}
+	else
+	{
+		name_completer->Fetch(ui->type_combo_box->currentData(Qt::UserRole).toInt(), ui->schema_combo_box->currentText());
+	}
+
 	ui->name_edit->setCompleter(name_completer);
 }
 
+// Restarts completer update delay
+// Fetch of previous type or schema is cancelled at once, so its names are not offered for the new one
+void BuilderWidget::ScheduleCompleterUpdate()
+{
+	name_completer->Clear();
+	completer_timer->start();
+}
+
 // Handles open explorer button click
 void BuilderWidget::OnExplorerButtonClicked()
 {
@@ -269,8 +450,15 @@ void BuilderWidget::OnExplorerButtonClicked()
 }
 
 // Handles build button click, calls build method
+// While build is running, the button cancels it
 void BuilderWidget::OnBuildButtonClicked()
 {
+	if (build_job)
+	{
+		build_job->Cancel();
+		return;
+	}
+
 	if (!CheckConnection())
 	{
 		return;
@@ -307,22 +495,14 @@ void BuilderWidget::OnBuildButtonClicked()
 		"Are you sure to continue?"
 		, QMessageBox::Ok | QMessageBox::Cancel, QMessageBox::Cancel);
 
-	if (dialog_result == QMessageBox::Ok)
+	QString error_message;
+
+	if (dialog_result == QMessageBox::Ok && !StartPatchBuild(ui->patch_path_edit->text(), error_message))
 	{
-		if (StartPatchBuild(ui->patch_path_edit->text()))
-		{
-			QApplication::beep();
-			QMessageBox::information(this, "Build completed"
-				, "Build completed. See log for details"
-				, QMessageBox::Ok, QMessageBox::Ok);
-		}
-		else
-		{
-			QApplication::beep();
-			QMessageBox::warning(this, "Build error"
-				, "Error occured. See log for details"
-				, QMessageBox::Ok, QMessageBox::Ok);			
-		}
+		QApplication::beep();
+		QMessageBox::warning(this, "Build error"
+			, "Error occured: " + error_message
+			, QMessageBox::Ok, QMessageBox::Ok);
 	}
 }
 
@@ -330,13 +510,13 @@ void BuilderWidget::OnBuildButtonClicked()
 void BuilderWidget::OnRemoveButtonClicked()
 {
 	const auto dialog_result = QMessageBox::question(this, "Remove item", "Are you sure to remove " +
-		ui->build_list_widget->currentItem()->text(PatchListWidget::ColumnIndexes::name_column) +
+		ui->build_list_widget->GetName(ui->build_list_widget->CurrentRow()) +
 		" from patch list?"
 		, QMessageBox::Ok | QMessageBox::Cancel, QMessageBox::Cancel);
 
-	if (dialog_result == QMessageBox::Ok && ui->build_list_widget->topLevelItemCount() != 0)
+	if (dialog_result == QMessageBox::Ok && ui->build_list_widget->Count() != 0)
 	{
-		ui->build_list_widget->takeTopLevelItem(ui->build_list_widget->currentIndex().row());
+		ui->build_list_widget->Remove(ui->build_list_widget->CurrentRow());
 		emit ItemCountChanged();
 	}
 }
@@ -344,24 +524,20 @@ void BuilderWidget::OnRemoveButtonClicked()
 // Handles move item up button click
 void BuilderWidget::OnMoveUpButtonClicked()
 {
-	if (ui->build_list_widget->topLevelItemCount() > 1 && ui->build_list_widget->currentIndex().row() > 0)
+	if (ui->build_list_widget->Count() > 1 && ui->build_list_widget->CurrentRow() > 0)
 	{
-		const auto selected_row = ui->build_list_widget->currentIndex().row();
-		const auto selected_item = ui->build_list_widget->takeTopLevelItem(ui->build_list_widget->currentIndex().row());
-		ui->build_list_widget->insertTopLevelItem(selected_row - 1, selected_item);
-		ui->build_list_widget->setCurrentItem(selected_item);
+		const auto selected_row = ui->build_list_widget->CurrentRow();
+		ui->build_list_widget->Move(selected_row, selected_row - 1);
 	}	
 }
 
 // Handles move item down button click
 void BuilderWidget::OnMoveDownButtonClicked()
 {
-	if (ui->build_list_widget->topLevelItemCount() > 1 && ui->build_list_widget->currentIndex().row() != ui->build_list_widget->topLevelItemCount() - 1)
+	if (ui->build_list_widget->Count() > 1 && ui->build_list_widget->CurrentRow() != ui->build_list_widget->Count() - 1)
 	{
-		const auto selected_row = ui->build_list_widget->currentIndex().row();
-		const auto selected_item = ui->build_list_widget->takeTopLevelItem(selected_row);
-		ui->build_list_widget->insertTopLevelItem(selected_row + 1, selected_item);
-		ui->build_list_widget->setCurrentItem(selected_item);
+		const auto selected_row = ui->build_list_widget->CurrentRow();
+		ui->build_list_widget->Move(selected_row, selected_row + 1);
 	}	
 }
 
@@ -371,9 +547,9 @@ void BuilderWidget::OnClearButtonClicked()
 	const auto dialog_result = QMessageBox::question(this, "Clear list", "Are you sure to clear patch list?"
 		, QMessageBox::Ok | QMessageBox::Cancel, QMessageBox::Cancel);
 
-	if (dialog_result == QMessageBox::Ok && ui->build_list_widget->topLevelItemCount() != 0)
+	if (dialog_result == QMessageBox::Ok && ui->build_list_widget->Count() != 0)
 	{
-		ui->build_list_widget->clear();
+		ui->build_list_widget->Clear();
 		emit ItemCountChanged();
 	}
 }
@@ -382,7 +558,7 @@ void BuilderWidget::OnClearButtonClicked()
 // Enables operations with list elements if one of them is selected
 void BuilderWidget::OnItemSelectionChanged()
 {
-	if (ui->build_list_widget->selectedItems().isEmpty())
+	if (!ui->build_list_widget->selectionModel()->hasSelection())
 	{
 		ui->move_up_button->setDisabled(true);
 		ui->move_down_button->setDisabled(true);
@@ -400,7 +576,7 @@ void BuilderWidget::OnItemSelectionChanged()
 // Sets ui elements for object name input by selected type
 void BuilderWidget::OnCurrentTypeChanged(int type)
 {
-	InitCompleter();
+	ScheduleCompleterUpdate();
 
 	if (type == ObjectTypes::function)
 	{
@@ -416,6 +592,7 @@ void BuilderWidget::OnCurrentTypeChanged(int type)
 	else if (!ui->schema_combo_box->isEnabled())
 	{
 		ui->schema_combo_box->setEnabled(true);
+		ui->all_schemas_check_box->setEnabled(true);
 	}
 
 	if (type != ObjectTypes::function && type != ObjectTypes::script)
@@ -427,11 +604,43 @@ void BuilderWidget::OnCurrentTypeChanged(int type)
 }
 
 // Handles current schema change
+// In all schemas mode completer does not depend on current schema
 void BuilderWidget::OnCurrentSchemaChanged(const QString &schema)
+{
+	if (!ui->all_schemas_check_box->isChecked())
+	{
+		ScheduleCompleterUpdate();
+	}
+}
+
+// Handles all schemas check box toggle
+// Switches completer between current schema and all schemas
+void BuilderWidget::OnAllSchemasToggled(bool is_checked)
 {
 	InitCompleter();
 }
 
+// Handles finish of completer fetch
+// Shows amount of names and fetch latency in name input tooltip
+void BuilderWidget::OnCompleterFetched(int name_count, double milliseconds)
+{
+	ui->name_edit->setToolTip(QString("%1 names loaded in %2 ms").arg(name_count).arg(milliseconds, 0, 'f', 1));
+}
+
+// Handles failure of completer fetch
+// Completion is not essential, so the error is shown in name input tooltip instead of a message box
+void BuilderWidget::OnCompleterFetchFailed(const QString &error_message)
+{
+	ui->name_edit->setToolTip("Object names are not loaded: " + error_message);
+}
+
+// Handles acceptance of completion from all schemas
+// Selects schema of accepted object, its name is inserted by completer
+void BuilderWidget::OnCompletionSchemaAccepted(const QString &schema)
+{
+	ui->schema_combo_box->setCurrentText(schema);
+}
+
 // Handles current name input change
 // If it is a function, checks its signature with regular expression
 void BuilderWidget::OnNameTextChanged(const QString &input)
@@ -448,10 +657,10 @@ void BuilderWidget::OnNameTextChanged(const QString &input)
 // Enables build and clear options if the list is not empty
 void BuilderWidget::OnItemCountChanged()
 {
-	if (ui->build_list_widget->topLevelItemCount() == 0)
+	if (ui->build_list_widget->Count() == 0)
 	{
 		ui->clear_button->setDisabled(true);
-		ui->build_button->setDisabled(true);
+		ui->build_button->setDisabled(!build_job);
 	}
 	else if (!ui->clear_button->isEnabled())
 	{
@@ -469,52 +678,151 @@ void BuilderWidget::OnConnected()
 	InitCompleter();
 }
 
+// Handles catalog cache refresh
+// Reloads schema list and completer keeping current schema selected if it still exists
+void BuilderWidget::OnCatalogRefreshed()
+{
+	const auto current_schema = ui->schema_combo_box->currentText();
+	DatabaseProvider::InitSchemaListModel(*schema_list_model);
+
+	if (ui->schema_combo_box->findText(current_schema) != -1)
+	{
+		ui->schema_combo_box->setCurrentText(current_schema);
+	}
+
+	InitCompleter();
+}
+
 // Handles start of disconnection from database
 // Clears elements which depend on database
 void BuilderWidget::OnDisconnectionStarted()
 {
-	schema_list_model->clear();
+	completer_timer->stop();
+	schema_list_model->setStringList(QStringList());
 	name_completer->Finish();
 	ui->name_edit->setCompleter(nullptr);
-	ui->build_list_widget->clear();
-	ui->build_button->setDisabled(true);
+	ui->build_list_widget->Clear();
+	ui->build_button->setDisabled(!build_job);
 	ui->clear_button->setDisabled(true);
+	ui->add_button->setEnabled(true);
+	ui->import_button->setEnabled(true);
 }
 
-// Launches patch build
-bool BuilderWidget::StartPatchBuild(const QString &path)
+// Launches patch build in background
+// Returns false if build is not started, its result is handled when the job is finished
+bool BuilderWidget::StartPatchBuild(const QString &path, QString &error_message)
 {
 	auto is_successful = false;
 	const auto patch_dir = FileHandler::MakePatchDir(path, is_successful);
 
 	if (!is_successful)
 	{
+		error_message = "patch directory is not created in " + path;
 		return false;
 	}
 
 	PatchList build_list;
 
-	for (auto i = 0; i < ui->build_list_widget->topLevelItemCount(); ++i)
+	for (const auto current : ui->build_list_widget->GetObjects())
 	{
-		const auto current_item = ui->build_list_widget->topLevelItem(i);
-		auto name_split_result = current_item->text(PatchListWidget::ColumnIndexes::name_column).split(QRegExp("(\\ |\\,|\\(|\\))")
+		auto name_split_result = current.GetName().split(QRegExp("(\\ |\\,|\\(|\\))")
 			, QString::SkipEmptyParts);
 		const auto item_name = name_split_result.first();
 		name_split_result.pop_front();
-		build_list.Add(current_item->data(PatchListWidget::ColumnIndexes::type_column, Qt::UserRole).toInt()
-			, current_item->text(PatchListWidget::ColumnIndexes::schema_column)
-			, item_name, name_split_result);
+		build_list.Add(current.GetType(), current.GetSchema(), item_name, name_split_result);
 	}
 
-	if (!FileHandler::MakePatchList(patch_dir.absolutePath(), build_list))
+	if (!FileHandler::MakePatchList(patch_dir.absolutePath(), build_list, error_message))
 	{
+		error_message = FileHandler::GetPatchListName() + " is not written: " + error_message;
 		return false;
 	}
 
-	const auto build_result = BuilderHandler::BuildPatch(DatabaseProvider::Database(), DatabaseProvider::User(), DatabaseProvider::Password()
-		, DatabaseProvider::Host(), DatabaseProvider::Port(), patch_dir.absolutePath(), patch_dir.absoluteFilePath(FileHandler::GetPatchListName()));
+	const auto patch_path = patch_dir.absolutePath();
+	build_job = BuilderHandler::BuildPatch(DatabaseProvider::Database(), DatabaseProvider::User(), DatabaseProvider::Password()
+		, DatabaseProvider::Host(), DatabaseProvider::Port(), patch_path, patch_dir.absoluteFilePath(FileHandler::GetPatchListName()), this);
+
+	connect(build_job, &ProcessJob::Progress, this, &BuilderWidget::OnBuildProgress);
+	connect(build_job, &ProcessJob::Finished, this, [this, patch_path](bool is_successful, const QString &error_message)
+	{
+		OnBuildFinished(patch_path, is_successful, error_message);
+	});
+
+	SetBuildRunning(true);
+	build_job->Start();
+	return true;
+}
+
+// Switches interface between running build and build list editing
+// While build is running, build button cancels it
+void BuilderWidget::SetBuildRunning(bool is_running)
+{
+	ui->build_progress_bar->setVisible(is_running);
+	ui->patch_path_edit->setDisabled(is_running);
+	ui->explorer_button->setDisabled(is_running);
+
+	if (is_running)
+	{
+		ui->build_progress_bar->setFormat("Building...");
+		ui->build_button->setText("Cancel");
+		ui->build_button->setIcon(QIcon(":/images/close.svg"));
+		ui->build_button->setEnabled(true);
+	}
+	else
+	{
+		ui->build_button->setText("Build");
+		ui->build_button->setIcon(QIcon(":/images/hammer.svg"));
+		ui->build_button->setEnabled(ui->build_list_widget->Count() != 0 && DatabaseProvider::IsConnected());
+	}
+}
+
+// Handles build progress report
+// Builder has no progress protocol, so elapsed time and amount of its output lines are shown
+void BuilderWidget::OnBuildProgress(int output_line_count, qint64 elapsed_time)
+{
+	ui->build_progress_bar->setFormat(QString("Building... %1 s, %2 log lines").arg(elapsed_time / 1000).arg(output_line_count));
+}
+
+// Handles build finish
+// Removes temporary build list and makes manifest of successfully built patch
+void BuilderWidget::OnBuildFinished(const QString &patch_path, bool is_successful, const QString &error_message)
+{
+	build_job->deleteLater();
+	build_job = nullptr;
+	SetBuildRunning(false);
+
+	QFile::remove(QDir(patch_path).absoluteFilePath(FileHandler::GetPatchListName()));
+
+	// Manifest lets the installer open the patch without parsing its text lists
+	// Lists are written by Builder, so they are parsed in background and a large patch does not block the interface
+	if (is_successful)
+	{
+		QThreadPool::globalInstance()->start(new FunctionTask([patch_path]()
+		{
+			QString manifest_error_message;
+
+			if (!FileHandler::MakeManifest(patch_path, manifest_error_message))
+			{
+				QMetaObject::invokeMethod(qApp, [manifest_error_message]()
+				{
+					BuilderHandler::WriteLog("Manifest is not written: " + manifest_error_message);
+				}, Qt::QueuedConnection);
+			}
+		}));
+	}
 
-	QFile::remove(patch_dir.absoluteFilePath(FileHandler::GetPatchListName()));
+	QApplication::beep();
 
-	return build_result;
+	if (is_successful)
+	{
+		QMessageBox::information(this, "Build completed"
+			, "Build completed. See log for details"
+			, QMessageBox::Ok, QMessageBox::Ok);
+	}
+	else
+	{
+		QMessageBox::warning(this, "Build error"
+			, "Error occured: " + error_message + ". See log for details"
+			, QMessageBox::Ok, QMessageBox::Ok);
+	}
 }
\ No newline at end of file
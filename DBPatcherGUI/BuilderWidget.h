@@ -1,9 +1,13 @@
 #pragma once
 
 #include <QWidget>
+#include <QStringList>
 
-class QSqlQueryModel;
+class QStringListModel;
+class QTimer;
+class PatchList;
 class ObjectNameCompleter;
+class ProcessJob;
 
 // Namespace required by Qt for loading .ui form file
 namespace Ui
@@ -23,21 +27,31 @@ private:
 	// Pointer to ui object required by Qt for loading .ui form file
 	// Ui class is created in editor, and its elements are available through this pointer
 	Ui::BuilderWidget *ui;
-	// Pointer to the schema list model, which can be filled with query execution
-	QSqlQueryModel *schema_list_model;
+	// Pointer to the schema list model, which is filled from catalog cache
+	QStringListModel *schema_list_model;
 	// Completer object which provides auto-completion of object name user's input
 	ObjectNameCompleter *name_completer;
+	// Timer delaying completer update, so fast switching of type or schema causes one fetch
+	QTimer *completer_timer;
+	// Delay of completer update in milliseconds
+	static const int completer_delay;
+	// Running Builder job, null if build is not started
+	ProcessJob *build_job;
 	void AddScripts(const QString &input);
+	void ImportObjects(const PatchList &objects, const QStringList &rejected_lines);
 	bool CheckConnection();
 	void InitScriptInput();
 	void InitCompleter();
-	bool StartPatchBuild(const QString &path);
+	void ScheduleCompleterUpdate();
+	bool StartPatchBuild(const QString &path, QString &error_message);
+	void SetBuildRunning(bool is_running);
 signals:
 	void ConnectionRequested();
 	void ItemCountChanged();
 public slots:
 	void OnConnected();
 	void OnDisconnectionStarted();
+	void OnCatalogRefreshed();
 private slots:
 	void OnAddButtonClicked();
 	void OnBuildButtonClicked();
@@ -46,9 +60,17 @@ private slots:
 	void OnMoveDownButtonClicked();
 	void OnRemoveButtonClicked();
 	void OnClearButtonClicked();
+	void OnImportFileTriggered();
+	void OnImportClipboardTriggered();
 	void OnItemSelectionChanged();
 	void OnCurrentTypeChanged(int type);
 	void OnCurrentSchemaChanged(const QString &schema);
+	void OnAllSchemasToggled(bool is_checked);
+	void OnCompletionSchemaAccepted(const QString &schema);
+	void OnCompleterFetched(int name_count, double milliseconds);
+	void OnCompleterFetchFailed(const QString &error_message);
 	void OnNameTextChanged(const QString &input);
 	void OnItemCountChanged();
+	void OnBuildProgress(int output_line_count, qint64 elapsed_time);
+	void OnBuildFinished(const QString &patch_path, bool is_successful, const QString &error_message);
 };
\ No newline at end of file
@@ -0,0 +1,682 @@
+#include "CatalogCache.h"
+#include "DatabaseProvider.h"
+#include "ObjectTypes.h"
+#include "QueryExecutor.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QVector>
+#include <cstring>
+
+// Header of snapshot file
+// It is followed by fixed-width records of all catalogs in catalog order and by UTF-8 string table
+// Its size depends on amount of catalogs, so the format version is changed when a catalog is added
+struct CatalogCache::SnapshotHeader
+{
+	char magic[4];
+	quint32 version;
+	qint64 xmin;
+	quint64 system_identifier;
+	quint32 database_oid;
+	quint32 entry_counts[catalog_count];
+	quint32 strings_size;
+};
+
+// Snapshot file record of one catalog row
+struct CatalogCache::SnapshotRecord
+{
+	quint32 oid;
+	quint32 parent;
+	qint32 type;
+	quint32 name_offset;
+	quint32 name_size;
+};
+
+bool CatalogCache::is_loaded = false;
+int CatalogCache::generation = 0;
+CatalogCache::Snapshot CatalogCache::snapshot;
+QStringList CatalogCache::schemas;
+QHash<QPair<int, QString>, QStringList> CatalogCache::names;
+QSet<CatalogObject> CatalogCache::objects;
+int CatalogCache::hits = 0;
+int CatalogCache::misses = 0;
+QString CatalogCache::snapshot_directory = "";
+QString CatalogCache::snapshot_address = "";
+int CatalogCache::update_job = 0;
+QList<CatalogCache::PendingUpdate> CatalogCache::pending_updates;
+
+const QByteArray CatalogCache::snapshot_magic = "PGCS";
+const quint32 CatalogCache::snapshot_version = 3;
+
+const QString CatalogCache::user_namespace_condition = " n.nspname NOT IN ('pg_catalog', 'information_schema')"
+	" AND n.nspname NOT LIKE 'pg_toast%' AND n.nspname NOT LIKE 'pg_temp%'";
+
+const QString CatalogCache::snapshot_query = "SELECT txid_snapshot_xmin(txid_current_snapshot()), s.system_identifier, d.oid"
+	" FROM pg_catalog.pg_control_system() s, pg_catalog.pg_database d WHERE d.datname = current_database();";
+
+// Every change query returns oid, parent oid, name and relation kind of rows with xmin not older than the bound value
+const QString CatalogCache::change_queries[catalog_count] = {
+	"SELECT n.oid, 0, n.nspname, '' FROM pg_catalog.pg_namespace n WHERE CAST(CAST(n.xmin AS text) AS bigint) >= ?;"
+	, "SELECT c.oid, c.relnamespace, c.relname, CAST(c.relkind AS text) FROM pg_catalog.pg_class c"
+		" JOIN pg_catalog.pg_namespace n ON n.oid = c.relnamespace WHERE c.relkind IN ('r', 'p', 'f', 'S', 'v', 'i', 'I') AND"
+		+ user_namespace_condition + " AND CAST(CAST(c.xmin AS text) AS bigint) >= ?;"
+	, "SELECT t.oid, t.tgrelid, t.tgname, '' FROM pg_catalog.pg_trigger t WHERE NOT t.tgisinternal"
+		" AND CAST(CAST(t.xmin AS text) AS bigint) >= ?;"
+	, "SELECT p.oid, p.pronamespace, p.proname || '(' || COALESCE(array_to_string(p.proargnames, ',', '*'), '') || ')', ''"
+		" FROM pg_catalog.pg_proc p JOIN pg_catalog.pg_namespace n ON n.oid = p.pronamespace"
+		" JOIN pg_catalog.pg_language l ON l.oid = p.prolang WHERE l.lanname = 'plpgsql' AND"
+		+ user_namespace_condition + " AND CAST(CAST(p.xmin AS text) AS bigint) >= ?;" };
+
+const QString CatalogCache::count_queries[catalog_count] = {
+	"SELECT count(*) FROM pg_catalog.pg_namespace n;"
+	, "SELECT count(*) FROM pg_catalog.pg_class c JOIN pg_catalog.pg_namespace n ON n.oid = c.relnamespace"
+		" WHERE c.relkind IN ('r', 'p', 'f', 'S', 'v', 'i', 'I') AND" + user_namespace_condition + ";"
+	, "SELECT count(*) FROM pg_catalog.pg_trigger t WHERE NOT t.tgisinternal;"
+	, "SELECT count(*) FROM pg_catalog.pg_proc p JOIN pg_catalog.pg_namespace n ON n.oid = p.pronamespace"
+		" JOIN pg_catalog.pg_language l ON l.oid = p.prolang WHERE l.lanname = 'plpgsql' AND" + user_namespace_condition + ";" };
+
+const QString CatalogCache::oid_queries[catalog_count] = {
+	"SELECT n.oid FROM pg_catalog.pg_namespace n;"
+	, "SELECT c.oid FROM pg_catalog.pg_class c JOIN pg_catalog.pg_namespace n ON n.oid = c.relnamespace"
+		" WHERE c.relkind IN ('r', 'p', 'f', 'S', 'v', 'i', 'I') AND" + user_namespace_condition + ";"
+	, "SELECT t.oid FROM pg_catalog.pg_trigger t WHERE NOT t.tgisinternal;"
+	, "SELECT p.oid FROM pg_catalog.pg_proc p JOIN pg_catalog.pg_namespace n ON n.oid = p.pronamespace"
+		" JOIN pg_catalog.pg_language l ON l.oid = p.prolang WHERE l.lanname = 'plpgsql' AND" + user_namespace_condition + ";" };
+
+const QHash<QString, int> CatalogCache::relation_kinds = QHash<QString, int>({ {"r", ObjectTypes::table}, {"p", ObjectTypes::table}
+	, {"f", ObjectTypes::table}, {"S", ObjectTypes::sequence}, {"v", ObjectTypes::view}, {"i", ObjectTypes::index}
+	, {"I", ObjectTypes::index} });
+
+// Updates catalog snapshot by executor, keeping hit and miss counters
+// Full snapshot is fetched if it is not loaded, otherwise only rows changed since last update are fetched
+// The result is applied in the main thread, after that on_finished is called unless context is deleted
+// Update requested while another one is running is queued and started after it, so no request is dropped
+// The result is dropped if snapshot was replaced or invalidated meanwhile
+void CatalogCache::Update(QObject *context, const std::function<void(bool, const QString&)> &on_finished)
+{
+	// Result of update job
+	struct UpdateResult
+	{
+		Snapshot snapshot;
+		bool is_successful = false;
+		QString error_message;
+	};
+
+	if (update_job != 0 && DatabaseProvider::FindExecutor("catalog"))
+	{
+		pending_updates.append({ context, on_finished });
+		return;
+	}
+
+	const auto executor = DatabaseProvider::Executor("catalog");
+
+	if (!executor)
+	{
+		on_finished(false, "No connection to database");
+		return;
+	}
+
+	const auto started_generation = generation;
+	const auto is_incremental = is_loaded;
+	const auto base_snapshot = snapshot;
+
+	update_job = executor->Submit([=](QSqlDatabase &connection)
+	{
+		UpdateResult result;
+		result.snapshot = base_snapshot;
+		result.is_successful = is_incremental ? FetchDelta(connection, result.snapshot, result.error_message)
+			: FetchFull(connection, result.snapshot, result.error_message);
+		return result;
+	}, context, [=](const UpdateResult &result)
+	{
+		if (started_generation != generation)
+		{
+			return;
+		}
+
+		update_job = 0;
+
+		if (result.is_successful)
+		{
+			Replace(result.snapshot);
+			SaveSnapshot();
+		}
+
+		on_finished(result.is_successful, result.error_message);
+		StartPendingUpdate();
+	});
+}
+
+// Starts the first queued update whose context still exists, the rest wait for it
+void CatalogCache::StartPendingUpdate()
+{
+	while (!pending_updates.isEmpty())
+	{
+		const auto pending = pending_updates.takeFirst();
+
+		if (pending.context)
+		{
+			Update(pending.context, pending.on_finished);
+			return;
+		}
+	}
+}
+
+// Loads catalog snapshot of current database from disk
+// Returns false if there is no snapshot file or it is damaged or written by another format version
+bool CatalogCache::LoadSnapshot()
+{
+	QFile file(SnapshotPath());
+
+	if (snapshot_directory.isEmpty() || !file.open(QIODevice::ReadOnly) || file.size() < qint64(sizeof(SnapshotHeader)))
+	{
+		return false;
+	}
+
+	const auto data = file.map(0, file.size());
+
+	if (!data)
+	{
+		return false;
+	}
+
+	SnapshotHeader header;
+	std::memcpy(&header, data, sizeof(header));
+
+	if (std::memcmp(header.magic, snapshot_magic.constData(), sizeof(header.magic)) != 0 || header.version != snapshot_version)
+	{
+		return false;
+	}
+
+	qint64 record_count = 0;
+
+	for (const auto current : header.entry_counts)
+	{
+		record_count += current;
+	}
+
+	if (qint64(sizeof(header)) + record_count * qint64(sizeof(SnapshotRecord)) + header.strings_size != file.size())
+	{
+		return false;
+	}
+
+	const auto records = data + sizeof(header);
+	const auto strings = reinterpret_cast<const char*>(records + record_count * sizeof(SnapshotRecord));
+	Snapshot new_snapshot;
+	new_snapshot.state.xmin = header.xmin;
+	new_snapshot.state.system_identifier = header.system_identifier;
+	new_snapshot.state.database_oid = header.database_oid;
+	qint64 record_index = 0;
+
+	for (auto i = 0; i < catalog_count; ++i)
+	{
+		auto &catalog_entries = new_snapshot.entries[i];
+		catalog_entries.reserve(header.entry_counts[i]);
+
+		for (quint32 j = 0; j < header.entry_counts[i]; ++j, ++record_index)
+		{
+			SnapshotRecord record;
+			std::memcpy(&record, records + record_index * sizeof(SnapshotRecord), sizeof(record));
+
+			if (qint64(record.name_offset) + record.name_size > header.strings_size)
+			{
+				return false;
+			}
+
+			catalog_entries.insert(record.oid, { record.parent, record.type
+				, QString::fromUtf8(strings + record.name_offset, record.name_size) });
+		}
+	}
+
+	Replace(new_snapshot);
+	return true;
+}
+
+// Writes catalog snapshot of current database to disk
+// File is replaced atomically, so a damaged snapshot is never left on disk
+bool CatalogCache::SaveSnapshot()
+{
+	if (!is_loaded || snapshot_directory.isEmpty() || !QDir().mkpath(snapshot_directory))
+	{
+		return false;
+	}
+
+	SnapshotHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, snapshot_magic.constData(), sizeof(header.magic));
+	header.version = snapshot_version;
+	header.xmin = snapshot.state.xmin;
+	header.system_identifier = snapshot.state.system_identifier;
+	header.database_oid = snapshot.state.database_oid;
+
+	QVector<SnapshotRecord> records;
+	QByteArray strings;
+
+	for (auto i = 0; i < catalog_count; ++i)
+	{
+		header.entry_counts[i] = snapshot.entries[i].count();
+
+		for (auto j = snapshot.entries[i].constBegin(); j != snapshot.entries[i].constEnd(); ++j)
+		{
+			const auto name = j->name.toUtf8();
+			records.append({ j.key(), j->parent, j->type, quint32(strings.size()), quint32(name.size()) });
+			strings.append(name);
+		}
+	}
+
+	header.strings_size = strings.size();
+
+	QSaveFile file(SnapshotPath());
+
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		return false;
+	}
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(records.constData()), records.count() * sizeof(SnapshotRecord));
+	file.write(strings);
+	return file.commit();
+}
+
+// Sets directory for snapshot files
+void CatalogCache::SetSnapshotDirectory(const QString &path)
+{
+	snapshot_directory = path;
+}
+
+// Drops catalog snapshot and resets counters
+// Snapshot file stays on disk for the next connection
+void CatalogCache::Invalidate()
+{
+	Clear();
+	hits = 0;
+	misses = 0;
+}
+
+// Cancels running and queued updates, their results are dropped
+// Snapshot is kept, so reconnection to the same database refreshes it incrementally
+void CatalogCache::StopUpdate()
+{
+	const auto running_executor = DatabaseProvider::FindExecutor("catalog");
+
+	if (update_job != 0 && running_executor)
+	{
+		running_executor->Cancel(update_job);
+	}
+
+	update_job = 0;
+	pending_updates.clear();
+}
+
+// Checks if catalog snapshot is loaded
+bool CatalogCache::IsLoaded()
+{
+	return is_loaded;
+}
+
+// Checks if catalog snapshot is loaded for database of current connection
+bool CatalogCache::IsLoadedForCurrentDatabase()
+{
+	return is_loaded && snapshot_address == Address();
+}
+
+// Checks object for existence in catalog snapshot and counts the result
+bool CatalogCache::Contains(int type, const QString &schema, const QString &name)
+{
+	if (is_loaded && objects.contains({ type, schema, name }))
+	{
+		++hits;
+		return true;
+	}
+
+	++misses;
+	return false;
+}
+
+// Returns names of user schemas
+QStringList CatalogCache::Schemas()
+{
+	return schemas;
+}
+
+// Returns sorted names of objects by type and schema
+QStringList CatalogCache::Names(int type, const QString &schema)
+{
+	return names.value(qMakePair(type, schema));
+}
+
+// Returns objects of all schemas by type, sorted by schema and name
+QList<CatalogObject> CatalogCache::Objects(int type)
+{
+	QList<CatalogObject> result;
+
+	for (const auto &schema : schemas)
+	{
+		for (const auto &name : names.value(qMakePair(type, schema)))
+		{
+			result.append(CatalogObject{ type, schema, name });
+		}
+	}
+
+	return result;
+}
+
+// Returns amount of objects in catalog snapshot
+int CatalogCache::Count()
+{
+	return objects.count();
+}
+
+// Getter for hits
+int CatalogCache::Hits()
+{
+	return hits;
+}
+
+// Getter for misses
+int CatalogCache::Misses()
+{
+	return misses;
+}
+
+// Returns amount of rows fetched from database by last load or refresh
+int CatalogCache::TransferredRows()
+{
+	return snapshot.transferred_rows;
+}
+
+// Returns counter increased on every snapshot replacement, so data derived from cache can be rebuilt when it changes
+int CatalogCache::Generation()
+{
+	return generation;
+}
+
+// Clears catalog snapshot
+void CatalogCache::Clear()
+{
+	is_loaded = false;
+	update_job = 0;
+	pending_updates.clear();
+	snapshot_address = "";
+	++generation;
+	snapshot = Snapshot();
+	schemas.clear();
+	names.clear();
+	objects.clear();
+}
+
+// Replaces current snapshot and rebuilds indexes
+void CatalogCache::Replace(const Snapshot &new_snapshot)
+{
+	snapshot = new_snapshot;
+	snapshot_address = Address();
+	++generation;
+	RebuildIndex();
+	is_loaded = true;
+}
+
+// Returns connection address of current database
+QString CatalogCache::Address()
+{
+	return QString("%1:%2/%3").arg(DatabaseProvider::Host()).arg(DatabaseProvider::Port()).arg(DatabaseProvider::Database());
+}
+
+// Returns path of snapshot file for current database
+// File name is a hash of connection address, so it is valid on every file system
+QString CatalogCache::SnapshotPath()
+{
+	const auto hash = QCryptographicHash::hash(Address().toUtf8(), QCryptographicHash::Sha1).toHex();
+	return QDir(snapshot_directory).absoluteFilePath(hash + ".snapshot");
+}
+
+// Fetches all rows of tracked catalogs
+bool CatalogCache::FetchFull(QSqlDatabase &connection, Snapshot &target, QString &error_message)
+{
+	target = Snapshot();
+	SnapshotState new_state;
+
+	if (!FetchSnapshotState(connection, target, new_state, error_message))
+	{
+		return false;
+	}
+
+	for (auto i = 0; i < catalog_count; ++i)
+	{
+		if (!FetchChanges(connection, target, static_cast<Catalog>(i), 0, error_message))
+		{
+			return false;
+		}
+	}
+
+	target.state = new_state;
+	return true;
+}
+
+// Merges rows changed since target snapshot into it and removes dropped rows
+// Falls back to full fetch if transaction counter has wrapped around or the snapshot belongs to another database
+bool CatalogCache::FetchDelta(QSqlDatabase &connection, Snapshot &target, QString &error_message)
+{
+	SnapshotState new_state;
+	target.transferred_rows = 0;
+
+	if (!FetchSnapshotState(connection, target, new_state, error_message))
+	{
+		return false;
+	}
+
+	// Row xmin is a 32-bit transaction id, so it can be compared only within one epoch
+	// Transaction ids of a recreated cluster or database say nothing about rows of the old one
+	if ((new_state.xmin >> 32) != (target.state.xmin >> 32) || new_state.system_identifier != target.state.system_identifier
+		|| new_state.database_oid != target.state.database_oid)
+	{
+		return FetchFull(connection, target, error_message);
+	}
+
+	for (auto i = 0; i < catalog_count; ++i)
+	{
+		if (!FetchChanges(connection, target, static_cast<Catalog>(i), target.state.xmin & 0xFFFFFFFF, error_message)
+			|| !RemoveDropped(connection, target, static_cast<Catalog>(i), error_message))
+		{
+			return false;
+		}
+	}
+
+	target.state = new_state;
+	return true;
+}
+
+// Gets id of the oldest transaction still running in database together with cluster identifier and database oid
+bool CatalogCache::FetchSnapshotState(QSqlDatabase &connection, Snapshot &target, SnapshotState &state, QString &error_message)
+{
+	QSqlQuery fetch(connection);
+
+	if (!fetch.exec(snapshot_query) || !fetch.next())
+	{
+		error_message = fetch.lastError().text();
+		return false;
+	}
+
+	state.xmin = fetch.value(0).toLongLong();
+	state.system_identifier = fetch.value(1).toLongLong();
+	state.database_oid = fetch.value(2).toUInt();
+	++target.transferred_rows;
+	return true;
+}
+
+// Merges catalog rows with xmin not older than given transaction id into snapshot
+bool CatalogCache::FetchChanges(QSqlDatabase &connection, Snapshot &target, Catalog catalog, qint64 since, QString &error_message)
+{
+	QSqlQuery fetch(connection);
+	fetch.setForwardOnly(true);
+	fetch.prepare(change_queries[catalog]);
+	fetch.addBindValue(since);
+
+	if (!fetch.exec())
+	{
+		error_message = fetch.lastError().text();
+		return false;
+	}
+
+	auto &catalog_entries = target.entries[catalog];
+
+	while (fetch.next())
+	{
+		auto type = ObjectTypes::type_count;
+
+		switch (catalog)
+		{
+			case relation_catalog:
+			{
+				type = static_cast<ObjectTypes::Type>(relation_kinds.value(fetch.value(3).toString(), ObjectTypes::type_count));
+				break;
+			}
+			case trigger_catalog:
+			{
+				type = ObjectTypes::trigger;
+				break;
+			}
+			case function_catalog:
+			{
+				type = ObjectTypes::function;
+				break;
+			}
+			default:
+			{
+				break;
+			}
+		}
+
+		catalog_entries.insert(fetch.value(0).toUInt(), { fetch.value(1).toUInt(), type, fetch.value(2).toString() });
+		++target.transferred_rows;
+	}
+
+	return true;
+}
+
+// Removes rows which do not exist in database anymore
+// Oid list is fetched only if amount of rows differs from the one in database
+bool CatalogCache::RemoveDropped(QSqlDatabase &connection, Snapshot &target, Catalog catalog, QString &error_message)
+{
+	auto &catalog_entries = target.entries[catalog];
+	QSqlQuery fetch(connection);
+	fetch.setForwardOnly(true);
+
+	if (!fetch.exec(count_queries[catalog]) || !fetch.next())
+	{
+		error_message = fetch.lastError().text();
+		return false;
+	}
+
+	++target.transferred_rows;
+
+	if (fetch.value(0).toInt() == catalog_entries.count())
+	{
+		return true;
+	}
+
+	if (!fetch.exec(oid_queries[catalog]))
+	{
+		error_message = fetch.lastError().text();
+		return false;
+	}
+
+	QSet<uint> existing_oids;
+
+	while (fetch.next())
+	{
+		existing_oids.insert(fetch.value(0).toUInt());
+		++target.transferred_rows;
+	}
+
+	for (auto i = catalog_entries.begin(); i != catalog_entries.end();)
+	{
+		if (existing_oids.contains(i.key()))
+		{
+			++i;
+		}
+		else
+		{
+			i = catalog_entries.erase(i);
+		}
+	}
+
+	return true;
+}
+
+// Checks if schema is not a system one
+bool CatalogCache::IsUserSchema(const QString &name)
+{
+	return name != "pg_catalog" && name != "information_schema" && !name.startsWith("pg_toast")
+		&& !name.startsWith("pg_temp");
+}
+
+// Rebuilds completion and existence indexes from catalog rows
+// Schema names are resolved here, so renamed schemas and moved relations need no refetch of dependent rows
+void CatalogCache::RebuildIndex()
+{
+	schemas.clear();
+	names.clear();
+	objects.clear();
+
+	const auto &namespaces = snapshot.entries[namespace_catalog];
+	const auto &relations = snapshot.entries[relation_catalog];
+
+	for (const auto &current : namespaces)
+	{
+		if (IsUserSchema(current.name))
+		{
+			schemas.append(current.name);
+		}
+	}
+
+	schemas.sort();
+
+	const auto insert = [&namespaces](int type, uint namespace_oid, const QString &name)
+	{
+		const auto schema_entry = namespaces.constFind(namespace_oid);
+
+		if (type == ObjectTypes::type_count || schema_entry == namespaces.constEnd() || !IsUserSchema(schema_entry->name))
+		{
+			return;
+		}
+
+		const CatalogObject object = { type, schema_entry->name, name };
+
+		if (!objects.contains(object))
+		{
+			objects.insert(object);
+			names[qMakePair(type, schema_entry->name)].append(name);
+		}
+	};
+
+	for (const auto &current : relations)
+	{
+		insert(current.type, current.parent, current.name);
+	}
+
+	for (const auto &current : snapshot.entries[trigger_catalog])
+	{
+		const auto relation = relations.constFind(current.parent);
+
+		if (relation != relations.constEnd())
+		{
+			insert(current.type, relation->parent, current.name);
+		}
+	}
+
+	for (const auto &current : snapshot.entries[function_catalog])
+	{
+		insert(current.type, current.parent, current.name);
+	}
+
+	for (auto &current : names)
+	{
+		current.sort();
+	}
+}
\ No newline at end of file
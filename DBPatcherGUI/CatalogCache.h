@@ -0,0 +1,159 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QPointer>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <functional>
+
+class QSqlDatabase;
+
+// Database object identity used as a key of catalog cache
+struct CatalogObject
+{
+	int type;
+	QString schema;
+	QString name;
+};
+
+inline bool operator==(const CatalogObject &lhs, const CatalogObject &rhs)
+{
+	return lhs.type == rhs.type && lhs.name == rhs.name && lhs.schema == rhs.schema;
+}
+
+inline uint qHash(const CatalogObject &key, uint seed = 0)
+{
+	return qHash(key.name, qHash(key.schema, seed ^ uint(key.type)));
+}
+
+// Row of system catalog kept in catalog cache
+struct CatalogEntry
+{
+	// Oid of namespace or relation the row belongs to
+	uint parent;
+	// Object type index
+	int type;
+	// Object name or function signature
+	QString name;
+};
+
+// Class keeping a local snapshot of database catalog
+// Answers object name completion and existence checks without server round-trips
+// Snapshot is stored on disk for every database, so it is available right after connection
+class CatalogCache
+{
+public:
+	CatalogCache() = delete;
+	static void Update(QObject *context, const std::function<void(bool, const QString&)> &on_finished);
+	static bool LoadSnapshot();
+	static bool SaveSnapshot();
+	static void SetSnapshotDirectory(const QString &path);
+	static void Invalidate();
+	static void StopUpdate();
+	static bool IsLoaded();
+	static bool IsLoadedForCurrentDatabase();
+	static bool Contains(int type, const QString &schema, const QString &name);
+	static QStringList Schemas();
+	static QStringList Names(int type, const QString &schema);
+	static QList<CatalogObject> Objects(int type);
+	static int Count();
+	static int Hits();
+	static int Misses();
+	static int TransferredRows();
+	static int Generation();
+private:
+	// Indexes of tracked system catalogs
+	enum Catalog
+	{
+		namespace_catalog,
+		relation_catalog,
+		trigger_catalog,
+		function_catalog,
+		catalog_count
+	};
+
+	// Server state the snapshot was taken at
+	struct SnapshotState
+	{
+		// Oldest transaction running at the moment of last load or refresh
+		// Catalog rows with not older xmin are fetched on the next refresh
+		qint64 xmin = 0;
+		// Identifier of database cluster, it is changed when the cluster is recreated or restored from dump
+		quint64 system_identifier = 0;
+		// Oid of database, it is changed when the database is recreated under the same name
+		uint database_oid = 0;
+	};
+
+	// Catalog rows together with the server state for incremental refresh
+	struct Snapshot
+	{
+		SnapshotState state;
+		// Amount of rows fetched from database by last load or refresh
+		int transferred_rows = 0;
+		// Rows of tracked system catalogs by oid
+		QHash<uint, CatalogEntry> entries[catalog_count];
+	};
+
+	// Update requested while another one is running, it is started when the running one is finished
+	struct PendingUpdate
+	{
+		QPointer<QObject> context;
+		std::function<void(bool, const QString&)> on_finished;
+	};
+
+	struct SnapshotHeader;
+	struct SnapshotRecord;
+
+	// Flag showing if snapshot is loaded
+	static bool is_loaded;
+	// Counter increased on every snapshot replacement, used to drop outdated background results
+	static int generation;
+	// Current catalog snapshot
+	static Snapshot snapshot;
+	// Names of user schemas
+	static QStringList schemas;
+	// Sorted object names grouped by type and schema, used for completion
+	static QHash<QPair<int, QString>, QStringList> names;
+	// Set of all objects, used for existence checks
+	static QSet<CatalogObject> objects;
+	// Counters of existence checks answered and not answered from cache
+	static int hits;
+	static int misses;
+	// Directory for snapshot files
+	static QString snapshot_directory;
+	// Connection address of database the snapshot belongs to
+	static QString snapshot_address;
+	// Id of running update job, 0 if there is no one
+	static int update_job;
+	// Updates waiting for the running one
+	static QList<PendingUpdate> pending_updates;
+	// Snapshot file signature and format version
+	static const QByteArray snapshot_magic;
+	static const quint32 snapshot_version;
+	// Condition excluding system namespaces from object queries
+	static const QString user_namespace_condition;
+	// Query for oldest running transaction, cluster identifier and database oid
+	static const QString snapshot_query;
+	// Queries for catalog rows changed since given transaction, amount of rows and their oids
+	static const QString change_queries[catalog_count];
+	static const QString count_queries[catalog_count];
+	static const QString oid_queries[catalog_count];
+	// Hash for object types by pg_class relation kinds
+	static const QHash<QString, int> relation_kinds;
+	static void Clear();
+	static void StartPendingUpdate();
+	static void Replace(const Snapshot &new_snapshot);
+	static QString Address();
+	static QString SnapshotPath();
+	static bool FetchFull(QSqlDatabase &connection, Snapshot &target, QString &error_message);
+	static bool FetchDelta(QSqlDatabase &connection, Snapshot &target, QString &error_message);
+	static bool FetchSnapshotState(QSqlDatabase &connection, Snapshot &target, SnapshotState &state, QString &error_message);
+	static bool FetchChanges(QSqlDatabase &connection, Snapshot &target, Catalog catalog, qint64 since, QString &error_message);
+	static bool RemoveDropped(QSqlDatabase &connection, Snapshot &target, Catalog catalog, QString &error_message);
+	static bool IsUserSchema(const QString &name);
+	static void RebuildIndex();
+};
\ No newline at end of file
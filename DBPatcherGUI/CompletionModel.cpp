@@ -0,0 +1,107 @@
+#include "CompletionModel.h"
+
+#include <QTimer>
+
+const int CompletionModel::batch_size = 16;
+
+// Constructor
+CompletionModel::CompletionModel(QObject *parent)
+	: QAbstractListModel(parent)
+	, append_timer(new QTimer(this))
+{
+	append_timer->setInterval(0);
+	connect(append_timer, &QTimer::timeout, this, &CompletionModel::OnAppendTimerTimeout);
+}
+
+// Returns number of rows shown in the popup
+int CompletionModel::rowCount(const QModelIndex &parent) const
+{
+	return parent.isValid() ? 0 : rows.count();
+}
+
+// Returns row data: qualified name for display, object name for edit and schema for schema role
+QVariant CompletionModel::data(const QModelIndex &index, int role) const
+{
+	if (!index.isValid() || index.row() >= rows.count())
+	{
+		return QVariant();
+	}
+
+	const auto &row = rows.at(index.row());
+
+	switch (role)
+	{
+		case Qt::DisplayRole:
+		{
+			return row.schema.isEmpty() ? row.name : row.schema + "." + row.name;
+		}
+		case Qt::EditRole:
+		{
+			return row.name;
+		}
+		case schema_role:
+		{
+			return row.schema;
+		}
+		default:
+		{
+			return QVariant();
+		}
+	}
+}
+
+// Replaces current rows with results
+// Common leading rows are kept, the rest is removed and new rows are appended in batches
+void CompletionModel::SetResults(const QList<CompletionItem> &results)
+{
+	append_timer->stop();
+	auto common_count = 0;
+
+	while (common_count < rows.count() && common_count < results.count() && rows.at(common_count) == results.at(common_count))
+	{
+		++common_count;
+	}
+
+	if (common_count < rows.count())
+	{
+		beginRemoveRows(QModelIndex(), common_count, rows.count() - 1);
+		rows.erase(rows.begin() + common_count, rows.end());
+		endRemoveRows();
+	}
+
+	pending_rows = results.mid(common_count);
+	OnAppendTimerTimeout();
+}
+
+// Removes all rows
+void CompletionModel::Clear()
+{
+	SetResults(QList<CompletionItem>());
+}
+
+// Handles append timer timeout
+// Appends the next batch of pending rows and waits for the next event loop iteration if something is left
+void CompletionModel::OnAppendTimerTimeout()
+{
+	if (pending_rows.isEmpty())
+	{
+		append_timer->stop();
+		return;
+	}
+
+	const auto batch = pending_rows.mid(0, batch_size);
+	pending_rows.erase(pending_rows.begin(), pending_rows.begin() + batch.count());
+
+	beginInsertRows(QModelIndex(), rows.count(), rows.count() + batch.count() - 1);
+	rows.append(batch);
+	endInsertRows();
+
+	if (pending_rows.isEmpty())
+	{
+		append_timer->stop();
+	}
+	else
+	{
+		append_timer->start();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QList>
+#include <QString>
+
+class QTimer;
+
+// Completion result, schema is empty when all results belong to the current schema
+struct CompletionItem
+{
+	QString name;
+	QString schema;
+};
+
+inline bool operator==(const CompletionItem &lhs, const CompletionItem &rhs)
+{
+	return lhs.name == rhs.name && lhs.schema == rhs.schema;
+}
+
+inline bool operator!=(const CompletionItem &lhs, const CompletionItem &rhs)
+{
+	return !(lhs == rhs);
+}
+
+// Class implementing list model of completion results
+// New results replace only rows which differ from current ones and are appended in batches,
+// so the popup shows the best matches at once and is not reset on every keystroke
+// Edit role gives object name inserted into input, display role shows its schema too if it is set
+class CompletionModel : public QAbstractListModel
+{
+	Q_OBJECT
+
+public:
+	// Role giving schema of the result
+	static const int schema_role = Qt::UserRole;
+
+	CompletionModel(QObject *parent = nullptr);
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+	void SetResults(const QList<CompletionItem> &results);
+	void Clear();
+private:
+	// Rows shown in the popup
+	QList<CompletionItem> rows;
+	// Results not yet appended to rows
+	QList<CompletionItem> pending_rows;
+	// Timer appending pending rows
+	QTimer *append_timer;
+	// Number of rows appended at once
+	static const int batch_size;
+private slots:
+	void OnAppendTimerTimeout();
+};
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "ConnectionPool.h"
+#include "QueryExecutor.h"
+
+#include <QTimer>
+
+// Constructor, opens minimum number of connections in background
+// Limits are taken here, so the first fill already honours them and no connection is opened for minimum 0
+ConnectionPool::ConnectionPool(const QString &database, const QString &user, const QString &password,
+	const QString &server, int port, int minimum, int maximum, int idle_timeout, QObject *parent)
+	: QObject(parent)
+	, database(database)
+	, user(user)
+	, password(password)
+	, server(server)
+	, port(port)
+	, maximum(qMax(1, maximum))
+	, idle_timeout(qMax(1000, idle_timeout))
+	, idle_timer(new QTimer(this))
+{
+	this->minimum = qBound(0, minimum, this->maximum);
+	idle_timer->setInterval(this->idle_timeout / 2);
+	connect(idle_timer, &QTimer::timeout, this, &ConnectionPool::OnIdleTimerTimeout);
+	idle_timer->start();
+	FillToMinimum();
+}
+
+// Destructor, closes all connections cancelling their jobs
+ConnectionPool::~ConnectionPool()
+{
+	qDeleteAll(executors);
+}
+
+// Sets number of connections kept open and upper limit of connections
+// Connections above new maximum are closed when they become idle
+void ConnectionPool::SetLimits(int minimum, int maximum)
+{
+	this->maximum = qMax(1, maximum);
+	this->minimum = qBound(0, minimum, this->maximum);
+	FillToMinimum();
+}
+
+// Sets time after which an idle connection above minimum is closed
+void ConnectionPool::SetIdleTimeout(int milliseconds)
+{
+	idle_timeout = qMax(1000, milliseconds);
+	idle_timer->setInterval(idle_timeout / 2);
+}
+
+// Checks out connection by name, so jobs of one name run in order and jobs of different names run concurrently
+// Connection is created if the pool is not full, otherwise the least loaded one is shared
+QueryExecutor* ConnectionPool::Connection(const QString &name)
+{
+	if (named_executors.contains(name))
+	{
+		return named_executors.value(name);
+	}
+
+	QueryExecutor *selected = nullptr;
+
+	// Connections opened for minimum are given to names first
+	for (const auto current : executors)
+	{
+		if (!named_executors.key(current).isNull())
+		{
+			continue;
+		}
+
+		selected = current;
+		break;
+	}
+
+	if (!selected && executors.count() < maximum)
+	{
+		selected = AddExecutor();
+	}
+
+	if (!selected)
+	{
+		for (const auto current : executors)
+		{
+			if (!selected || current->PendingCount() < selected->PendingCount())
+			{
+				selected = current;
+			}
+		}
+	}
+
+	named_executors.insert(name, selected);
+	return selected;
+}
+
+// Returns connection checked out by name or nullptr if there is no one
+// Does not create connections, so it is used for cancellation
+QueryExecutor* ConnectionPool::Find(const QString &name) const
+{
+	return named_executors.value(name, nullptr);
+}
+
+// Returns number of open connections
+int ConnectionPool::Count() const
+{
+	return executors.count();
+}
+
+// Creates a connection and starts opening it in background
+QueryExecutor* ConnectionPool::AddExecutor()
+{
+	const auto executor = new QueryExecutor(database, user, password, server, port);
+	executor->Open();
+	executors.append(executor);
+	return executor;
+}
+
+// Closes a connection and forgets all names which have checked it out
+void ConnectionPool::RemoveExecutor(QueryExecutor *executor)
+{
+	for (auto i = named_executors.begin(); i != named_executors.end();)
+	{
+		if (i.value() == executor)
+		{
+			i = named_executors.erase(i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+
+	executors.removeOne(executor);
+	delete executor;
+}
+
+// Opens connections until their number reaches minimum
+void ConnectionPool::FillToMinimum()
+{
+	while (executors.count() < minimum)
+	{
+		AddExecutor();
+	}
+}
+
+// Handles idle timer timeout
+// Closes connections idle for longer than timeout while there are more of them than minimum
+void ConnectionPool::OnIdleTimerTimeout()
+{
+	for (const auto current : QList<QueryExecutor*>(executors))
+	{
+		if (executors.count() <= minimum)
+		{
+			break;
+		}
+
+		if (current->IdleTime() >= idle_timeout || (executors.count() > maximum && current->PendingCount() == 0))
+		{
+			RemoveExecutor(current);
+		}
+	}
+}
\ No newline at end of file
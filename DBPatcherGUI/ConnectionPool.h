@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QString>
+
+class QueryExecutor;
+class QTimer;
+
+// Class implementing pool of database connections checked out by name
+// Every pooled connection is owned by its QueryExecutor, so jobs submitted by different names run concurrently
+// When the pool is full, a new name shares the least loaded connection
+class ConnectionPool : public QObject
+{
+	Q_OBJECT
+
+public:
+	ConnectionPool(const QString &database, const QString &user, const QString &password,
+		const QString &server, int port, int minimum, int maximum, int idle_timeout, QObject *parent = nullptr);
+	~ConnectionPool();
+	void SetLimits(int minimum, int maximum);
+	void SetIdleTimeout(int milliseconds);
+	QueryExecutor* Connection(const QString &name);
+	QueryExecutor* Find(const QString &name) const;
+	int Count() const;
+private:
+	// Connection parameters
+	QString database;
+	QString user;
+	QString password;
+	QString server;
+	int port;
+	// Number of connections kept open while the pool exists
+	int minimum;
+	// Upper limit of connections
+	int maximum;
+	// Time in milliseconds after which an idle connection above minimum is closed
+	int idle_timeout;
+	// All pooled connections
+	QList<QueryExecutor*> executors;
+	// Connections checked out by name
+	QHash<QString, QueryExecutor*> named_executors;
+	// Timer closing idle connections
+	QTimer *idle_timer;
+	QueryExecutor* AddExecutor();
+	void RemoveExecutor(QueryExecutor *executor);
+	void FillToMinimum();
+private slots:
+	void OnIdleTimerTimeout();
+};
\ No newline at end of file
@@ -1,9 +1,45 @@
 #include "DatabaseProvider.h"
+#include "PatchList.h"
+#include "PatchListElement.h"
+#include "ObjectTypes.h"
+#include "CatalogCache.h"
+#include "QueryExecutor.h"
+#include "ConnectionPool.h"
 
+#include <QBitArray>
+#include <QPair>
 #include <QSqlDatabase>
 #include <QSqlError>
 #include <QSqlQuery>
-#include <QSqlQueryModel>
+#include <QStringListModel>
+
+ConnectionPool *DatabaseProvider::pool = nullptr;
+int DatabaseProvider::pool_minimum = 1;
+int DatabaseProvider::pool_maximum = 4;
+int DatabaseProvider::pool_idle_timeout = 60000;
+
+const QString DatabaseProvider::schema_query = "SELECT schema_name FROM information_schema.schemata WHERE"
+	" schema_name NOT IN ('pg_catalog', 'information_schema') AND schema_name NOT LIKE 'pg_toast%' AND schema_name NOT LIKE 'pg_temp%';";
+
+const QHash<int, QString> DatabaseProvider::batch_exists_queries = QHash<int, QString>({
+	{ ObjectTypes::table, "SELECT o.ordinal FROM unnest(CAST(? AS text[]), CAST(? AS text[])) WITH ORDINALITY AS o(schema_name, object_name, ordinal)"
+		" WHERE EXISTS (SELECT * FROM information_schema.tables WHERE table_schema = o.schema_name AND table_type != 'VIEW'"
+		" AND table_name = o.object_name);" }
+	, { ObjectTypes::sequence, "SELECT o.ordinal FROM unnest(CAST(? AS text[]), CAST(? AS text[])) WITH ORDINALITY AS o(schema_name, object_name, ordinal)"
+		" WHERE EXISTS (SELECT * FROM information_schema.sequences WHERE sequence_schema = o.schema_name"
+		" AND sequence_name = o.object_name);" }
+	, { ObjectTypes::function, "SELECT o.ordinal FROM unnest(CAST(? AS text[]), CAST(? AS text[])) WITH ORDINALITY AS o(schema_name, object_name, ordinal)"
+		" WHERE EXISTS (SELECT * FROM information_schema.routines r, pg_catalog.pg_proc p WHERE r.specific_schema = o.schema_name"
+		" AND r.routine_name||'('||COALESCE(array_to_string(p.proargnames, ',', '*'),'')||')' = o.object_name"
+		" AND r.external_language = 'PLPGSQL' AND r.routine_name = p.proname AND r.specific_name = p.proname || '_' || p.oid);" }
+	, { ObjectTypes::view, "SELECT o.ordinal FROM unnest(CAST(? AS text[]), CAST(? AS text[])) WITH ORDINALITY AS o(schema_name, object_name, ordinal)"
+		" WHERE EXISTS (SELECT * FROM information_schema.views WHERE table_schema = o.schema_name"
+		" AND table_name = o.object_name);" }
+	, { ObjectTypes::trigger, "SELECT o.ordinal FROM unnest(CAST(? AS text[]), CAST(? AS text[])) WITH ORDINALITY AS o(schema_name, object_name, ordinal)"
+		" WHERE EXISTS (SELECT * FROM information_schema.triggers WHERE trigger_schema = o.schema_name"
+		" AND trigger_name = o.object_name);" }
+	, { ObjectTypes::index, "SELECT o.ordinal FROM unnest(CAST(? AS text[]), CAST(? AS text[])) WITH ORDINALITY AS o(schema_name, object_name, ordinal)"
+		" WHERE EXISTS (SELECT * FROM pg_indexes WHERE schemaname = o.schema_name AND indexname = o.object_name);" } });
 
 // Returns name of current database
 QString DatabaseProvider::Database()
@@ -64,13 +100,21 @@ bool DatabaseProvider::Connect(const QString &database, const QString &user, con
 	{
 		error_message = connection.lastError().text();
 	}
+	else
+	{
+		pool = new ConnectionPool(database, user, password, server, port, pool_minimum, pool_maximum, pool_idle_timeout);
+	}
 
 	return is_connection_set;
 }
 
 // Disconnects from database
+// Pool is deleted first, so its jobs are cancelled before the main connection is closed
 void DatabaseProvider::Disconnect()
 {
+	delete pool;
+	pool = nullptr;
+
 	const auto connection_name = QSqlDatabase::database().connectionName();
 	auto connection = QSqlDatabase::database(connection_name, false);
 
@@ -82,88 +126,203 @@ void DatabaseProvider::Disconnect()
 	QSqlDatabase::removeDatabase(connection_name);
 }
 
-// Checks table for existence in database
-bool DatabaseProvider::TableExists(const QString &schema, const QString &name)
+// Checks out pooled connection by name for queries which must not block the main thread
+// Jobs of different names run concurrently, returns nullptr if there is no connection
+QueryExecutor* DatabaseProvider::Executor(const QString &name)
 {
-	QSqlQuery check;
-	check.prepare("SELECT EXISTS (SELECT * FROM information_schema.tables WHERE table_schema = ? AND table_type != 'VIEW'"
-		" AND table_name = ?)");
-	check.addBindValue(schema);
-	check.addBindValue(name);
-	check.exec();
-	check.next();
-	return check.value("exists").toBool();
+	return pool ? pool->Connection(name) : nullptr;
 }
 
-// Checks sequence for existence in database
-bool DatabaseProvider::SequenceExists(const QString &schema, const QString &name)
+// Returns pooled connection already checked out by name or nullptr, used for job cancellation
+QueryExecutor* DatabaseProvider::FindExecutor(const QString &name)
 {
-	QSqlQuery check;
-	check.prepare("SELECT EXISTS (SELECT * FROM information_schema.sequences WHERE sequence_schema = ?"
-		"AND sequence_name = ?)");
-	check.addBindValue(schema);
-	check.addBindValue(name);
-	check.exec();
-	check.next();
-	return check.value("exists").toBool();
+	return pool ? pool->Find(name) : nullptr;
 }
 
-// Checks function for existence in database
-bool DatabaseProvider::FunctionExists(const QString &schema, const QString &signature)
+// Sets connection pool limits and time in milliseconds after which idle connection is closed
+void DatabaseProvider::SetPoolLimits(int minimum, int maximum, int idle_timeout)
 {
-	QSqlQuery check;
-	check.prepare("SELECT EXISTS (SELECT * FROM information_schema.routines r, pg_catalog.pg_proc p WHERE"
-		" r.specific_schema = ? AND r.routine_name||'('||COALESCE(array_to_string(p.proargnames, ',', '*'),'')||')' = ?"
-		" AND r.external_language = 'PLPGSQL' AND r.routine_name = p.proname AND"
-		" r.specific_name = p.proname || '_' || p.oid);");
-	check.addBindValue(schema);
-	check.addBindValue(signature);
-	check.exec();
-	check.next();
-	return check.value("exists").toBool();
+	pool_minimum = minimum;
+	pool_maximum = maximum;
+	pool_idle_timeout = idle_timeout;
+
+	if (pool)
+	{
+		pool->SetLimits(minimum, maximum);
+		pool->SetIdleTimeout(idle_timeout);
+	}
+}
+
+// Returns upper limit of pooled connections, jobs spread over more names share connections
+int DatabaseProvider::ParallelConnectionCount()
+{
+	return pool_maximum;
 }
 
-// Checks view for existence in database
-bool DatabaseProvider::ViewExists(const QString &schema, const QString &name)
+// Checks if objects of the type can be checked for existence in database
+bool DatabaseProvider::CanCheckInDatabase(int type_index)
 {
-	QSqlQuery check;
-	check.prepare("SELECT EXISTS (SELECT * FROM information_schema.views WHERE table_schema = ?"
-		"AND table_name = ?)");
-	check.addBindValue(schema);
-	check.addBindValue(name);
-	check.exec();
-	check.next();
-	return check.value("exists").toBool();
+	return batch_exists_queries.contains(type_index);
 }
 
-// Checks trigger for existence in database
-bool DatabaseProvider::TriggerExists(const QString &schema, const QString &name)
+// Checks a batch of objects for existence in database with one query per object type
+// Returns bit array where each bit corresponds to the object with the same index in the list, error_message is set if a query fails
+// Does not use catalog cache, so it can be called in any thread with a connection owned by it
+QBitArray DatabaseProvider::ExistsMany(const PatchList &objects, QSqlDatabase &connection, QString &error_message)
 {
-	QSqlQuery check;
-	check.prepare("SELECT EXISTS (SELECT * FROM information_schema.triggers WHERE trigger_schema = ?"
-		"AND trigger_name = ?)");
-	check.addBindValue(schema);
-	check.addBindValue(name);
-	check.exec();
-	check.next();
-	return check.value("exists").toBool();
+	// Objects of one type collected for a single query
+	struct TypeBatch
+	{
+		QList<int> positions;
+		QStringList schemas;
+		QStringList names;
+	};
+
+	QBitArray result(objects.Count());
+	QHash<int, TypeBatch> batches;
+	auto position = 0;
+
+	for (const auto current : objects)
+	{
+		if (batch_exists_queries.contains(current.GetType()))
+		{
+			auto &batch = batches[current.GetType()];
+			batch.positions.append(position);
+			batch.schemas.append(current.GetSchema());
+			batch.names.append(current.GetName());
+		}
+
+		++position;
+	}
+
+	for (auto i = batches.constBegin(); i != batches.constEnd(); ++i)
+	{
+		QSqlQuery check(connection);
+		check.prepare(batch_exists_queries.value(i.key()));
+		check.addBindValue(ToArrayLiteral(i.value().schemas));
+		check.addBindValue(ToArrayLiteral(i.value().names));
+
+		if (!check.exec())
+		{
+			error_message = check.lastError().text();
+			continue;
+		}
+
+		while (check.next())
+		{
+			// Ordinal numbers returned by unnest start with 1
+			const auto ordinal = check.value("ordinal").toInt() - 1;
+
+			if (ordinal >= 0 && ordinal < i.value().positions.count())
+			{
+				result.setBit(i.value().positions.at(ordinal));
+			}
+		}
+	}
+
+	return result;
+}
+
+// Checks a batch of objects for existence using catalog cache
+// Objects not found in cache are checked in database by pooled connection, so the main thread is not blocked
+// on_finished is called with bit array of results and error message, empty if all objects are checked, unless context is deleted
+void DatabaseProvider::CheckExistence(const PatchList &objects, QObject *context, const std::function<void(const QBitArray&, const QString&)> &on_finished)
+{
+	QBitArray result(objects.Count());
+	PatchList misses;
+	QList<int> miss_positions;
+	auto position = 0;
+
+	for (const auto current : objects)
+	{
+		if (CatalogCache::IsLoaded() && CatalogCache::Contains(current.GetType(), current.GetSchema(), current.GetName()))
+		{
+			result.setBit(position);
+		}
+		else
+		{
+			misses.Add(current.GetType(), current.GetSchema(), current.GetName(), current.GetParameters());
+			miss_positions.append(position);
+		}
+
+		++position;
+	}
+
+	if (misses.Count() == 0)
+	{
+		on_finished(result, "");
+		return;
+	}
+
+	const auto executor = Executor("existence");
+
+	if (!executor)
+	{
+		on_finished(result, "No connection to database");
+		return;
+	}
+
+	executor->Submit([misses](QSqlDatabase &connection)
+	{
+		QString error_message = "";
+		const auto miss_result = ExistsMany(misses, connection, error_message);
+		return qMakePair(miss_result, error_message);
+	}, context, [=](const QPair<QBitArray, QString> &miss_result) mutable
+	{
+		for (auto i = 0; i < miss_positions.count(); ++i)
+		{
+			result.setBit(miss_positions.at(i), miss_result.first.testBit(i));
+		}
+
+		on_finished(result, miss_result.second);
+	});
 }
 
-// Checks index for existence in database
-bool DatabaseProvider::IndexExists(const QString &schema, const QString &name)
+// Makes PostgreSQL array literal from list of strings, so it can be bound as a single parameter
+QString DatabaseProvider::ToArrayLiteral(const QStringList &values)
 {
-	QSqlQuery check;
-	check.prepare("SELECT EXISTS (SELECT * FROM pg_indexes WHERE schemaname = ? AND indexname = ?);");
-	check.addBindValue(schema);
-	check.addBindValue(name);
-	check.exec();
-	check.next();
-	return check.value("exists").toBool();
+	QStringList quoted_values;
+	quoted_values.reserve(values.count());
+
+	for (auto current : values)
+	{
+		current.replace("\\", "\\\\").replace("\"", "\\\"");
+		quoted_values.append("\"" + current + "\"");
+	}
+
+	return "{" + quoted_values.join(",") + "}";
 }
 
-// Initializes schema list with data from database
-void DatabaseProvider::InitSchemaListModel(QSqlQueryModel &model)
+// Initializes schema list with data from catalog cache or from database if cache is not loaded
+// Database query is run by pooled connection, the model is filled when it is finished
+void DatabaseProvider::InitSchemaListModel(QStringListModel &model)
 {
-	model.setQuery("SELECT schema_name FROM information_schema.schemata WHERE"
-		" schema_name NOT IN ('pg_catalog', 'information_schema') AND schema_name NOT LIKE 'pg_toast%' AND schema_name NOT LIKE 'pg_temp%';");
+	if (CatalogCache::IsLoaded())
+	{
+		model.setStringList(CatalogCache::Schemas());
+		return;
+	}
+
+	const auto executor = Executor("completion");
+
+	if (!executor)
+	{
+		return;
+	}
+
+	executor->Submit([](QSqlDatabase &connection)
+	{
+		QStringList schemas;
+		QSqlQuery fetch(schema_query, connection);
+
+		while (fetch.next())
+		{
+			schemas.append(fetch.value(0).toString());
+		}
+
+		return schemas;
+	}, &model, [&model](const QStringList &schemas)
+	{
+		model.setStringList(schemas);
+	});
 }
\ No newline at end of file
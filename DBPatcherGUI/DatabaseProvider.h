@@ -1,9 +1,17 @@
 #pragma once
 
 #include <QString>
+#include <QStringList>
+#include <QHash>
+#include <functional>
 
+class QObject;
 class QSqlDatabase;
-class QSqlQueryModel;
+class QStringListModel;
+class QBitArray;
+class PatchList;
+class QueryExecutor;
+class ConnectionPool;
 
 // Class for database connection and retrieving information from it
 class DatabaseProvider
@@ -19,11 +27,25 @@ public:
 	static bool Connect(const QString &database, const QString &user, const QString &password,
 		const QString &server, const int port, QString &error_message);
 	static void Disconnect();
-	static bool TableExists(const QString &schema, const QString &name);
-	static bool SequenceExists(const QString &schema, const QString &name);
-	static bool FunctionExists(const QString &schema, const QString &signature);
-	static bool ViewExists(const QString &schema, const QString &name);
-	static bool TriggerExists(const QString &schema, const QString &name);
-	static bool IndexExists(const QString &schema, const QString &name);
-	static void InitSchemaListModel(QSqlQueryModel &model);
+	static QueryExecutor* Executor(const QString &name);
+	static QueryExecutor* FindExecutor(const QString &name);
+	static void SetPoolLimits(int minimum, int maximum, int idle_timeout);
+	static int ParallelConnectionCount();
+	static bool CanCheckInDatabase(int type_index);
+	static QBitArray ExistsMany(const PatchList &objects, QSqlDatabase &connection, QString &error_message);
+	static void CheckExistence(const PatchList &objects, QObject *context, const std::function<void(const QBitArray&, const QString&)> &on_finished);
+	static void InitSchemaListModel(QStringListModel &model);
+private:
+	// Pool of connections running queries off the main thread, exists while connection is established
+	static ConnectionPool *pool;
+	// Pool settings applied on connection
+	static int pool_minimum;
+	static int pool_maximum;
+	static int pool_idle_timeout;
+	// Query for user schema names
+	static const QString schema_query;
+	// Queries checking a batch of objects of one type for existence
+	// They take arrays of schemas and names and return ordinal numbers of existing objects
+	static const QHash<int, QString> batch_exists_queries;
+	static QString ToArrayLiteral(const QStringList &values);
 };
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "DependencyChecker.h"
+#include "DatabaseProvider.h"
+#include "QueryExecutor.h"
+#include "PatchList.h"
+#include "PatchListElement.h"
+
+#include <QBitArray>
+#include <QSqlDatabase>
+
+const int DependencyChecker::chunk_size = 2000;
+
+// Constructor
+DependencyChecker::DependencyChecker(QObject *parent)
+	: QObject(parent)
+	, chunk_count(0)
+	, finished_chunk_count(0)
+	, checked_count(0)
+	, is_running(false)
+	, is_cancelled(false)
+{
+}
+
+// Destructor, cancels queries of unfinished chunks
+DependencyChecker::~DependencyChecker()
+{
+	CancelJobs();
+}
+
+// Checks if all dependencies have types which can be checked in database
+bool DependencyChecker::CanCheck(const PatchList &dependencies)
+{
+	for (const auto current : dependencies)
+	{
+		if (!DatabaseProvider::CanCheckInDatabase(current.GetType()))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Splits dependencies into chunks and submits them to pooled connections by turns
+// Every connection gets its own name, so the pool gives separate connections while it is not full
+void DependencyChecker::Start(const PatchList &dependencies)
+{
+	is_running = true;
+	is_cancelled = false;
+	checked_count = 0;
+	finished_chunk_count = 0;
+	chunk_count = (dependencies.Count() + chunk_size - 1) / chunk_size;
+	elapsed_timer.start();
+
+	if (chunk_count == 0)
+	{
+		Finish(true, "");
+		return;
+	}
+
+	const auto connection_count = qMax(1, DatabaseProvider::ParallelConnectionCount());
+
+	for (auto chunk = 0; chunk < chunk_count; ++chunk)
+	{
+		const auto executor = DatabaseProvider::Executor(QString("dependency_check_%1").arg(chunk % connection_count + 1));
+
+		if (!executor)
+		{
+			CancelJobs();
+			Finish(false, "No connection to database");
+			return;
+		}
+
+		const auto first_row = chunk * chunk_size;
+		const auto last_row = qMin(first_row + chunk_size, dependencies.Count());
+		PatchList chunk_dependencies;
+		chunk_dependencies.Reserve(last_row - first_row);
+
+		for (auto row = first_row; row < last_row; ++row)
+		{
+			chunk_dependencies.Add(dependencies.GetType(row), dependencies.GetSchema(row), dependencies.GetName(row), dependencies.GetParameters(row));
+		}
+
+		const auto job_id = executor->Submit([chunk_dependencies](QSqlDatabase &connection)
+		{
+			QString error_message = "";
+			const auto check_result = DatabaseProvider::ExistsMany(chunk_dependencies, connection, error_message);
+			return qMakePair(check_result, error_message);
+		}, this, [this, first_row](const QPair<QBitArray, QString> &result)
+		{
+			if (!is_running)
+			{
+				return;
+			}
+
+			if (!result.second.isEmpty())
+			{
+				CancelJobs();
+				Finish(false, result.second);
+				return;
+			}
+
+			checked_count += result.first.count();
+			emit ResultsReady(first_row, result.first);
+
+			// Owner may cancel check while handling results
+			if (!is_running)
+			{
+				return;
+			}
+
+			emit Progress(checked_count, elapsed_timer.elapsed());
+
+			if (++finished_chunk_count == chunk_count)
+			{
+				jobs.clear();
+				Finish(true, "");
+			}
+		});
+
+		jobs.append(qMakePair(QPointer<QueryExecutor>(executor), job_id));
+	}
+}
+
+// Cancels check, waiting chunks are skipped and running queries are cancelled on server side
+// Finished signal reports unsuccessful result at once
+void DependencyChecker::Cancel()
+{
+	if (!is_running)
+	{
+		return;
+	}
+
+	is_cancelled = true;
+	CancelJobs();
+	Finish(false, "Cancelled by user");
+}
+
+// Checks if check is started and not finished yet
+bool DependencyChecker::IsRunning() const
+{
+	return is_running;
+}
+
+// Checks if check is cancelled by user
+bool DependencyChecker::IsCancelled() const
+{
+	return is_cancelled;
+}
+
+// Cancels submitted jobs whose connections still exist
+void DependencyChecker::CancelJobs()
+{
+	for (const auto &job : jobs)
+	{
+		if (job.first)
+		{
+			job.first->Cancel(job.second);
+		}
+	}
+
+	jobs.clear();
+}
+
+// Reports result of check
+void DependencyChecker::Finish(bool is_successful, const QString &error_message)
+{
+	is_running = false;
+	emit Finished(is_successful, error_message);
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QList>
+#include <QPair>
+#include <QPointer>
+
+class QBitArray;
+class PatchList;
+class QueryExecutor;
+
+// Class implementing dependency check inside the application
+// Dependencies are split into chunks, every chunk is checked by set-based catalog queries, one per object type,
+// and chunks are spread over several pooled connections, so they are checked in parallel.
+// Results of every chunk are reported as soon as it is checked. It is started by the owner after signals are connected
+class DependencyChecker : public QObject
+{
+	Q_OBJECT
+
+public:
+	DependencyChecker(QObject *parent = nullptr);
+	~DependencyChecker();
+	static bool CanCheck(const PatchList &dependencies);
+	void Start(const PatchList &dependencies);
+	void Cancel();
+	bool IsRunning() const;
+	bool IsCancelled() const;
+private:
+	// Submitted jobs of chunks with their connections, used for cancellation
+	QList<QPair<QPointer<QueryExecutor>, int>> jobs;
+	// Amount of chunks and amount of checked ones
+	int chunk_count;
+	int finished_chunk_count;
+	// Amount of checked dependencies
+	int checked_count;
+	// Flags showing if check is running and if it is cancelled by user
+	bool is_running;
+	bool is_cancelled;
+	// Time since the start
+	QElapsedTimer elapsed_timer;
+	// Amount of dependencies in chunk
+	static const int chunk_size;
+	void CancelJobs();
+	void Finish(bool is_successful, const QString &error_message);
+signals:
+	void ResultsReady(int first_row, const QBitArray &check_result);
+	void Progress(int checked_count, qint64 elapsed_time);
+	void Finished(bool is_successful, const QString &error_message);
+};
\ No newline at end of file
@@ -1,139 +1,120 @@
 #include "DependencyListWidget.h"
-#include "ObjectTypes.h"
+#include "ObjectListModel.h"
+#include "PatchList.h"
+#include "MappedListFile.h"
 
 #include <QHeaderView>
 #include <QBitArray>
 
-const QHash<int, QString> DependencyListWidget::status_icons = QHash<int, QString>({ {waiting_for_check, ":/images/unchecked.svg"}
-		, {satisfied, ":/images/checked.svg"}, {not_satisfied, ":/images/error.svg"} });
-
 // Constructor
 DependencyListWidget::DependencyListWidget(QWidget *parent)
-	: QTreeWidget(parent)
-	, checked_count(0)
-	, are_all_satisfied(true)
+	: QTreeView(parent)
+	, model(new ObjectListModel(true, this))
 {
-	setColumnCount(4);
-	QStringList header_labels;
-	header_labels.insert(type_column, "Type");
-	header_labels.insert(schema_column, "Schema");
-	header_labels.insert(name_column, "Name");
-	header_labels.insert(status_column, "Status");
-	setHeaderLabels(header_labels);
+	setModel(model);
 	setRootIsDecorated(false);
+	setUniformRowHeights(true);
 	setSelectionMode(SingleSelection);
 	header()->setStretchLastSection(false);
-	header()->setSectionResizeMode(type_column, QHeaderView::ResizeMode::ResizeToContents);
-	header()->setSectionResizeMode(schema_column, QHeaderView::ResizeMode::ResizeToContents);
-	header()->setSectionResizeMode(name_column, QHeaderView::ResizeMode::Stretch);
-	header()->setSectionResizeMode(status_column, QHeaderView::ResizeMode::ResizeToContents);
+	header()->setSectionResizeMode(ObjectListModel::type_column, QHeaderView::ResizeMode::ResizeToContents);
+	header()->setSectionResizeMode(ObjectListModel::schema_column, QHeaderView::ResizeMode::ResizeToContents);
+	header()->setSectionResizeMode(ObjectListModel::name_column, QHeaderView::ResizeMode::Stretch);
+	header()->setSectionResizeMode(ObjectListModel::status_column, QHeaderView::ResizeMode::ResizeToContents);
 	setSortingEnabled(true);
 
-	connect(this, SIGNAL(itemClicked(QTreeWidgetItem*, int)), SLOT(OnItemClicked(QTreeWidgetItem*, int)));
+	connect(this, &DependencyListWidget::clicked, this, &DependencyListWidget::OnItemClicked);
+	connect(model, &ObjectListModel::SourceLineInvalid, this, &DependencyListWidget::LineInvalid);
 }
 
 // Marks dependencies in list as satisfied/not satisfied by check result bit array
 bool DependencyListWidget::SetCheckStatus(const QBitArray& check_result)
 {
-	if (check_result.count() != topLevelItemCount())
+	if (!model->SetCheckStatus(check_result))
 	{
 		return false;
 	}
 
-	are_all_satisfied = true;
-
-	for (auto i = 0; i < check_result.count(); ++i)
-	{
-		const auto current = topLevelItem(i);
-
-		if (check_result[i])
-		{
-			++checked_count;
-			current->setCheckState(status_column, Qt::Checked);
-			current->setIcon(status_column, QIcon(status_icons.value(satisfied)));
-			current->setData(status_column, Qt::UserRole, satisfied);
-		}
-		else
-		{
-			are_all_satisfied = false;
-			current->setIcon(status_column, QIcon(status_icons.value(not_satisfied)));
-			current->setData(status_column, Qt::UserRole, not_satisfied);
-		}
-	}
-
 	emit ItemCheckChanged();
 	return true;
 }
 
-// Adds a new dependency to list and marks it as waiting for check
-void DependencyListWidget::Add(int type_index, const class QString &schema, const class QString &name)
+// Sets check status of a batch of dependencies starting from the given row
+// Check is not finished yet, so ItemCheckChanged is not emitted
+bool DependencyListWidget::SetCheckStatus(int first_row, const QBitArray &check_result)
 {
-	auto *new_item = new QTreeWidgetItem(this);
-	new_item->setIcon(type_column, QIcon(ObjectTypes::type_icons.value(type_index)));
-	new_item->setText(type_column, ObjectTypes::type_names.value(type_index));
-	new_item->setData(type_column, Qt::UserRole, type_index);
-	new_item->setText(schema_column, schema);
-	new_item->setText(name_column, name);
-	new_item->setIcon(status_column, QIcon(status_icons.value(waiting_for_check)));
-	new_item->setCheckState(status_column, Qt::Unchecked);
-	new_item->setData(status_column, Qt::UserRole, waiting_for_check);
-	new_item->setFlags(Qt::ItemIsEnabled);
-	addTopLevelItem(new_item);
+	return model->SetCheckStatus(first_row, check_result);
+}
+
+// Adds a batch of dependencies with one update and keeps the list sorted
+// Dependencies are added only by batches, so the list is sorted once for all of them
+void DependencyListWidget::Add(const PatchList &objects)
+{
+	model->Add(objects, false);
+	model->sort(header()->sortIndicatorSection(), header()->sortIndicatorOrder());
 }
 
 // Clears current list
 void DependencyListWidget::Clear()
 {
-	QTreeWidget::clear();
-	checked_count = 0;
-	are_all_satisfied = true;
+	model->Clear();
 }
 
-// Clears current list check state
-void DependencyListWidget::ClearCheck()
+// Shows dependency list file without keeping parsed objects, lines are decoded as they are shown
+// List is kept in file order until it is sorted by user
+bool DependencyListWidget::OpenMapped(const QString &path, QString &error_message)
 {
-	for (auto i = 0; i < topLevelItemCount(); ++i)
+	std::unique_ptr<MappedListFile> file(new MappedListFile(ListFileParser::dependency_list_format));
+
+	if (!file->Open(path, error_message))
 	{
-		const auto current = topLevelItem(i);
-		current->setCheckState(status_column, Qt::Unchecked);
-		current->setIcon(status_column, QIcon(status_icons.value(waiting_for_check)));
-		current->setData(status_column, Qt::UserRole, waiting_for_check);
+		return false;
 	}
 
-	checked_count = 0;
-	are_all_satisfied = true;
+	model->SetSource(std::move(file));
+	return true;
+}
+
+// Checks if list shows mapped file which is not changed
+bool DependencyListWidget::IsMapped() const
+{
+	return model->IsMapped();
+}
+
+// Clears current list check state
+void DependencyListWidget::ClearCheck()
+{
+	model->ClearCheck();
+}
+
+// Returns amount of dependencies in list
+int DependencyListWidget::Count() const
+{
+	return model->rowCount();
 }
 
 // Getter for checkedCount
 int DependencyListWidget::GetCheckedCount() const
 {
-	return checked_count;
+	return model->GetCheckedCount();
 }
 
 // Getter for are_all_satisfied
 bool DependencyListWidget::GetAreAllSatisfied() const
 {
-	return are_all_satisfied;
+	return model->GetAreAllSatisfied();
 }
 
-// Handles user's click on item
-void DependencyListWidget::OnItemClicked(QTreeWidgetItem *item, int column)
+// Returns dependencies of the list in list order, mapped file keeps order of its lines when it is sorted
+PatchList DependencyListWidget::GetObjects() const
 {
-	if (item->data(status_column, Qt::UserRole).toInt() == waiting_for_check)
-	{
-		return;
-	}
+	return model->GetObjects();
+}
 
-	if (item->checkState(status_column) != Qt::Checked)
-	{
-		++checked_count;
-		item->setCheckState(status_column, Qt::Checked);		
-	}
-	else
+// Handles user's click on item
+void DependencyListWidget::OnItemClicked(const QModelIndex &index)
+{
+	if (model->ToggleCheck(index.row()))
 	{
-		--checked_count;
-		item->setCheckState(status_column, Qt::Unchecked);
+		emit ItemCheckChanged();
 	}
-
-	emit ItemCheckChanged();
 }
\ No newline at end of file
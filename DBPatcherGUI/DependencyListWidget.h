@@ -1,45 +1,36 @@
 #pragma once
 
-#include <QTreeWidget>
+#include <QTreeView>
+
+class ObjectListModel;
+class PatchList;
+class QBitArray;
 
 // Class implementing graphical interface for dependency list
-class DependencyListWidget : public QTreeWidget
+// Dependencies are kept in table model, the view creates nothing per dependency and draws only visible rows
+class DependencyListWidget : public QTreeView
 {
 	Q_OBJECT
 
 public:
-
-	enum ColumnIndexes
-	{
-		type_column,
-		schema_column,
-		name_column,
-		status_column
-	};
-
-	enum CheckStatus
-	{
-		waiting_for_check,
-		satisfied,
-		not_satisfied
-	};
-
 	DependencyListWidget(QWidget *parent = nullptr);
 	bool SetCheckStatus(const QBitArray &check_result);
-	void Add(int type_index, const QString &schema, const QString &name);
+	bool SetCheckStatus(int first_row, const QBitArray &check_result);
+	void Add(const PatchList &objects);
 	void Clear();
+	bool OpenMapped(const QString &path, QString &error_message);
+	bool IsMapped() const;
 	void ClearCheck();
+	int Count() const;
 	int GetCheckedCount() const;
 	bool GetAreAllSatisfied() const;
+	PatchList GetObjects() const;
 private:
-	// Amount of checked (marked) dependencies in list
-	int checked_count;
-	// Flag showing if all dependencies are satisfied
-	bool are_all_satisfied;
-	// Hash for icon file paths
-	static const QHash<int, QString> status_icons;
+	// Model of dependencies
+	ObjectListModel *model;
 signals:
 	void ItemCheckChanged();
+	void LineInvalid(const QString &error_message);
 private slots:
-	void OnItemClicked(QTreeWidgetItem *item, int column);
-};
+	void OnItemClicked(const QModelIndex &index);
+};
\ No newline at end of file
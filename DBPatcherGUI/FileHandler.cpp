@@ -2,14 +2,61 @@
 #include "DatabaseProvider.h"
 #include "PatchListElement.h"
 #include "ObjectTypes.h"
+#include "ListFileParser.h"
+#include "ListFileWriter.h"
+#include "InstallerHandler.h"
 
 #include <QDir>
 #include <QDateTime>
 #include <QTextStream>
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QVector>
+#include <cstring>
+
+// Header of patch manifest
+// It is followed by fixed-width records of objects and dependencies, parameter references and UTF-8 string table.
+// Sizes and modification times of text lists show if the manifest still describes them
+struct ManifestHeader
+{
+	char magic[4];
+	quint32 version;
+	qint64 object_list_size;
+	qint64 object_list_time;
+	qint64 dependency_list_size;
+	qint64 dependency_list_time;
+	quint32 object_count;
+	quint32 dependency_count;
+	quint32 parameter_count;
+	quint32 strings_size;
+	char checksum[16];
+};
+
+// Reference to string of manifest string table
+struct ManifestString
+{
+	quint32 offset;
+	quint32 size;
+};
+
+// Manifest record of one object
+struct ManifestRecord
+{
+	qint32 type;
+	ManifestString schema;
+	ManifestString name;
+	quint32 parameter_first;
+	quint32 parameter_count;
+};
 
 const QString FileHandler::patch_list_name = "PatchList.txt";
 const QString FileHandler::dependency_list_name = "DependencyList.dpn";
 const QString FileHandler::object_list_name = "ObjectList.txt";
+const QString FileHandler::manifest_name = "Manifest.bin";
+const QByteArray FileHandler::manifest_magic = "PGPM";
+const quint32 FileHandler::manifest_version = 1;
+const int FileHandler::manifest_hash_block_size = 16 * 1024 * 1024;
 
 // Makes directory for patch files
 QDir FileHandler::MakePatchDir(const QString &path, bool &is_successful)
@@ -29,192 +76,408 @@ QDir FileHandler::MakePatchDir(const QString &path, bool &is_successful)
 }
 
 // Makes patch list file from PatchList object
-bool FileHandler::MakePatchList(const QString &path, const PatchList &patch_list)
+bool FileHandler::MakePatchList(const QString &path, const PatchList &patch_list, QString &error_message)
 {
-	const QDir patch_dir(path);
-	QFile file(patch_dir.absoluteFilePath(patch_list_name));
+	ListFileWriter writer(QDir(path).absoluteFilePath(patch_list_name));
 
-	if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::NewOnly))
+	if (!writer.Open())
 	{
+		error_message = writer.GetErrorMessage();
 		return false;
 	}
 
-	QTextStream patch_file_stream(&file);
-
 	for (const auto current : patch_list)
 	{
-		if (current->GetType() == ObjectTypes::script)
+		if (current.GetType() == ObjectTypes::script)
 		{
-			patch_file_stream << ObjectTypes::type_names.value(current->GetType()) << " " << current->GetName();
+			writer.Write(ObjectTypes::type_names.value(current.GetType()));
+			writer.Write(' ');
+			writer.Write(current.GetName());
 		}
 		else
 		{
-			patch_file_stream << current->GetSchema() << " " << current->GetName() << " " << ObjectTypes::type_names.value(current->GetType());
+			writer.Write(current.GetSchema());
+			writer.Write(' ');
+			writer.Write(current.GetName());
+			writer.Write(' ');
+			writer.Write(ObjectTypes::type_names.value(current.GetType()));
 
-			if (current->GetType() == ObjectTypes::function)
+			if (current.GetType() == ObjectTypes::function)
 			{
-				patch_file_stream << " " << GetParametersString(current->GetParameters());
+				writer.Write(' ');
+				writer.Write(GetParametersString(current.GetParameters()));
 			}
 		}
 
-		patch_file_stream << endl;
+		writer.EndLine();
+	}
+
+	if (!writer.Commit())
+	{
+		error_message = writer.GetErrorMessage();
+		return false;
 	}
 
-	file.close();
 	return true;
 }
 
-bool FileHandler::MakeDependencyList(const QString &path, const PatchList &dependency_list)
+// Makes dependency list file from PatchList object
+// Existing file is replaced only when the new one is completely written
+bool FileHandler::MakeDependencyList(const QString &path, const PatchList &dependency_list, QString &error_message)
 {
-	const QDir patch_dir(path);
-	QFile temp_file(patch_dir.absoluteFilePath("temp.dpn"));
-	QFile file(patch_dir.absoluteFilePath(dependency_list_name));
+	ListFileWriter writer(QDir(path).absoluteFilePath(dependency_list_name));
 
-	if (!temp_file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::NewOnly))
+	if (!writer.Open())
 	{
+		error_message = writer.GetErrorMessage();
 		return false;
 	}
 
-	QTextStream dependency_file_stream(&temp_file);
-
 	for (const auto current : dependency_list)
 	{
-		dependency_file_stream << current->GetSchema() << " " << current->GetName() << " "
-			<< ObjectTypes::type_names.value(current->GetType()) << endl;
+		writer.Write(current.GetSchema());
+		writer.Write(' ');
+		writer.Write(current.GetName());
+		writer.Write(' ');
+		writer.Write(ObjectTypes::type_names.value(current.GetType()));
+		writer.EndLine();
 	}
 
-	temp_file.close();
-
-	if (!file.remove())
+	if (!writer.Commit())
 	{
-		temp_file.remove();
+		error_message = writer.GetErrorMessage();
 		return false;
 	}
 
-	auto temp = temp_file.rename(patch_dir.absoluteFilePath(dependency_list_name));
 	return true;
 }
 
 // Returns PatchList object parsed from object list file
-PatchList FileHandler::ParseObjectList(const QString &path, bool &is_successful)
+// Error position and description are written to error_message
+PatchList FileHandler::ParseObjectList(const QString &path, bool &is_successful, QString &error_message)
 {
-	const QDir patch_dir(path);
-	QFile file(patch_dir.absoluteFilePath(object_list_name));
+	ListFileParser parser(ListFileParser::object_list_format);
+	const auto object_list = parser.Parse(QDir(path).absoluteFilePath(object_list_name), is_successful);
+	error_message = parser.GetErrorMessage();
+	return object_list;
+}
+
+// Returns PatchList object parsed from dependency list file
+// Error position and description are written to error_message
+PatchList FileHandler::ParseDependencyList(const QString &path, bool &is_successful, QString &error_message)
+{
+	ListFileParser parser(ListFileParser::dependency_list_format);
+	const auto dependency_list = parser.Parse(QDir(path).absoluteFilePath(dependency_list_name), is_successful);
+	error_message = parser.GetErrorMessage();
+	return dependency_list;
+}
 
-	if (!file.open(QIODevice::ReadOnly))
+// Parses text lists of patch and writes manifest for them
+bool FileHandler::MakeManifest(const QString &path, QString &error_message)
+{
+	auto is_successful = false;
+	const auto object_list = ParseObjectList(path, is_successful, error_message);
+
+	if (!is_successful)
 	{
-		is_successful = false;
-		return PatchList();
+		error_message = object_list_name + " is not parsed: " + error_message;
+		return false;
 	}
 
-	QTextStream input(&file);
-	PatchList object_list;
+	const auto dependency_list = ParseDependencyList(path, is_successful, error_message);
+
+	if (!is_successful)
+	{
+		error_message = dependency_list_name + " is not parsed: " + error_message;
+		return false;
+	}
+
+	return MakeManifest(path, object_list, dependency_list, error_message);
+}
 
-	while (!input.atEnd())
+// Writes binary manifest of patch objects and dependencies
+// Text lists stay the patch format for external tools, manifest only lets the patch be reopened without parsing them.
+// Equal strings are stored once, file is replaced atomically
+bool FileHandler::MakeManifest(const QString &path, const PatchList &object_list, const PatchList &dependency_list
+	, QString &error_message)
+{
+	const QDir patch_dir(path);
+	const QFileInfo object_list_info(patch_dir.absoluteFilePath(object_list_name));
+	const QFileInfo dependency_list_info(patch_dir.absoluteFilePath(dependency_list_name));
+
+	ManifestHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, manifest_magic.constData(), sizeof(header.magic));
+	header.version = manifest_version;
+	header.object_list_size = object_list_info.size();
+	header.object_list_time = object_list_info.lastModified().toMSecsSinceEpoch();
+	header.dependency_list_size = dependency_list_info.size();
+	header.dependency_list_time = dependency_list_info.lastModified().toMSecsSinceEpoch();
+	header.object_count = object_list.Count();
+	header.dependency_count = dependency_list.Count();
+
+	QVector<ManifestRecord> records;
+	QVector<ManifestString> parameters;
+	QByteArray strings;
+	QHash<QString, ManifestString> string_table;
+	records.reserve(object_list.Count() + dependency_list.Count());
+
+	const auto add_string = [&](const QString &value)
 	{
-		const QString read_string = input.readLine();
+		const auto found = string_table.constFind(value);
 
-		if (QRegExp("( )*").exactMatch(read_string))
+		if (found != string_table.constEnd())
 		{
-			continue;
+			return found.value();
 		}
 
-		int type = ObjectTypes::type_count;
-		QString schema_name = "";
-		QString name;
-		QStringList parameters = QStringList("");
+		const auto bytes = value.toUtf8();
+		const ManifestString reference = { quint32(strings.size()), quint32(bytes.size()) };
+		strings.append(bytes);
+		string_table.insert(value, reference);
+		return reference;
+	};
 
-		if (QRegExp("([^ ])+ ([^ ])+ (table|sequence|view|trigger|index)( )*").exactMatch(read_string))
+	for (const auto list : { &object_list, &dependency_list })
+	{
+		for (const auto current : *list)
 		{
-			const auto split_result = read_string.split(" ", QString::SkipEmptyParts);
-			schema_name = split_result.at(0);
-			name = split_result.at(1);
-			type = ObjectTypes::type_names.key(split_result.at(2));
+			const auto object_parameters = current.GetParameters();
+			records.append(ManifestRecord{ current.GetType(), add_string(current.GetSchema()), add_string(current.GetName())
+				, quint32(parameters.count()), quint32(object_parameters.count()) });
+
+			for (const auto &parameter : object_parameters)
+			{
+				parameters.append(add_string(parameter));
+			}
 		}
-		else if (QRegExp("script ([^ ])+( )*").exactMatch(read_string))
+	}
+
+	header.parameter_count = parameters.count();
+	header.strings_size = strings.size();
+
+	const auto records_data = QByteArray::fromRawData(reinterpret_cast<const char*>(records.constData()), records.count() * int(sizeof(ManifestRecord)));
+	const auto parameters_data = QByteArray::fromRawData(reinterpret_cast<const char*>(parameters.constData()), parameters.count() * int(sizeof(ManifestString)));
+	QCryptographicHash checksum(QCryptographicHash::Md5);
+	checksum.addData(records_data);
+	checksum.addData(parameters_data);
+	checksum.addData(strings);
+	std::memcpy(header.checksum, checksum.result().constData(), sizeof(header.checksum));
+
+	QSaveFile file(patch_dir.absoluteFilePath(manifest_name));
+
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		error_message = file.errorString();
+		return false;
+	}
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(records_data);
+	file.write(parameters_data);
+	file.write(strings);
+
+	if (!file.commit())
+	{
+		error_message = file.errorString();
+		return false;
+	}
+
+	return true;
+}
+
+// Reads objects and dependencies from binary manifest
+// Returns false if there is no manifest, it is damaged, written by another format version or text lists were changed after it
+bool FileHandler::ParseManifest(const QString &path, PatchList &object_list, PatchList &dependency_list)
+{
+	const QDir patch_dir(path);
+	QFile file(patch_dir.absoluteFilePath(manifest_name));
+
+	if (!file.open(QIODevice::ReadOnly) || file.size() < qint64(sizeof(ManifestHeader)))
+	{
+		return false;
+	}
+
+	const auto data = file.map(0, file.size());
+
+	if (!data)
+	{
+		return false;
+	}
+
+	ManifestHeader header;
+	std::memcpy(&header, data, sizeof(header));
+
+	if (std::memcmp(header.magic, manifest_magic.constData(), sizeof(header.magic)) != 0 || header.version != manifest_version)
+	{
+		return false;
+	}
+
+	const QFileInfo object_list_info(patch_dir.absoluteFilePath(object_list_name));
+	const QFileInfo dependency_list_info(patch_dir.absoluteFilePath(dependency_list_name));
+
+	if (header.object_list_size != object_list_info.size() || header.object_list_time != object_list_info.lastModified().toMSecsSinceEpoch()
+		|| header.dependency_list_size != dependency_list_info.size()
+		|| header.dependency_list_time != dependency_list_info.lastModified().toMSecsSinceEpoch())
+	{
+		return false;
+	}
+
+	const auto record_count = qint64(header.object_count) + header.dependency_count;
+	const auto body_size = record_count * qint64(sizeof(ManifestRecord)) + header.parameter_count * qint64(sizeof(ManifestString))
+		+ header.strings_size;
+
+	if (qint64(sizeof(header)) + body_size != file.size())
+	{
+		return false;
+	}
+
+	const auto body = reinterpret_cast<const char*>(data + sizeof(header));
+	QCryptographicHash checksum(QCryptographicHash::Md5);
+
+	// Body is hashed by blocks, as its size may not fit in int
+	for (qint64 offset = 0; offset < body_size; offset += manifest_hash_block_size)
+	{
+		checksum.addData(body + offset, int(qMin<qint64>(manifest_hash_block_size, body_size - offset)));
+	}
+
+	if (std::memcmp(header.checksum, checksum.result().constData(), sizeof(header.checksum)) != 0)
+	{
+		return false;
+	}
+
+	const auto records = body;
+	const auto parameters = records + record_count * sizeof(ManifestRecord);
+	const auto strings = parameters + header.parameter_count * sizeof(ManifestString);
+
+	// Schemas and parameters repeat, so each of them is decoded once
+	QHash<quint32, QString> decoded_strings;
+	auto is_valid = true;
+
+	const auto read_string = [&](const ManifestString &reference, bool is_repeated)
+	{
+		if (qint64(reference.offset) + reference.size > header.strings_size)
 		{
-			const auto split_result = read_string.split(" ", QString::SkipEmptyParts);
-			name = split_result.at(1);
-			type = ObjectTypes::script;
+			is_valid = false;
+			return QString();
 		}
-		else if (QRegExp("([^ ])+ ([^ ])+ function \\( (([^,() ])+ )*\\)( )*").exactMatch(read_string))
+
+		if (!is_repeated)
 		{
-			auto split_result = read_string.split(QRegExp("(\\ |\\(|\\))"), QString::SkipEmptyParts);
-			schema_name = split_result.first();
-			split_result.pop_front();
-			name = split_result.first();
-			split_result.pop_front();
-			type = ObjectTypes::function;
-			split_result.pop_front();
+			return QString::fromUtf8(strings + reference.offset, int(reference.size));
+		}
 
-			if (!split_result.isEmpty())
-			{
-				parameters = split_result;
-			}
+		auto found = decoded_strings.find(reference.offset);
+
+		if (found == decoded_strings.end())
+		{
+			found = decoded_strings.insert(reference.offset, QString::fromUtf8(strings + reference.offset, int(reference.size)));
 		}
-		else
+
+		return found.value();
+	};
+
+	PatchList new_object_list;
+	PatchList new_dependency_list;
+	new_object_list.Reserve(header.object_count);
+	new_dependency_list.Reserve(header.dependency_count);
+
+	for (qint64 i = 0; i < record_count && is_valid; ++i)
+	{
+		ManifestRecord record;
+		std::memcpy(&record, records + i * sizeof(ManifestRecord), sizeof(record));
+
+		if (record.type < 0 || record.type >= ObjectTypes::type_count
+			|| qint64(record.parameter_first) + record.parameter_count > header.parameter_count)
 		{
-			file.close();
-			is_successful = false;
-			return PatchList();
+			return false;
 		}
 
-		object_list.Add(type, schema_name, name, parameters);
+		QStringList object_parameters;
+
+		for (auto j = record.parameter_first; j < record.parameter_first + record.parameter_count; ++j)
+		{
+			ManifestString parameter;
+			std::memcpy(&parameter, parameters + j * sizeof(ManifestString), sizeof(parameter));
+			object_parameters.append(read_string(parameter, true));
+		}
+
+		auto &list = i < header.object_count ? new_object_list : new_dependency_list;
+		list.Add(record.type, read_string(record.schema, true), read_string(record.name, false), object_parameters);
 	}
 
-	file.close();
-	is_successful = true;
-	return object_list;
+	if (!is_valid)
+	{
+		return false;
+	}
+
+	object_list = std::move(new_object_list);
+	dependency_list = std::move(new_dependency_list);
+	return true;
 }
 
-// Returns PatchList object parsed from dependency list file
-PatchList FileHandler::ParseDependencyList(const QString &path, bool &is_successful)
+// Returns objects parsed from import file in patch list or CSV format
+PatchList FileHandler::ParseImportFile(const QString &path, QStringList &rejected_lines, bool &is_successful)
 {
-	const QDir patch_dir(path);
-	QFile file(patch_dir.absoluteFilePath(dependency_list_name));
+	QFile file(path);
 
-	if (!file.open(QIODevice::ReadOnly))
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
 	{
 		is_successful = false;
 		return PatchList();
 	}
 
 	QTextStream input(&file);
-	PatchList dependency_list;
+	const auto object_list = ParseImportText(input.readAll(), rejected_lines);
+	file.close();
+	is_successful = true;
+	return object_list;
+}
 
-	while (!input.atEnd())
+// Returns objects parsed from text with one object per line
+// Every line may be written in patch list format or as CSV record "type,schema,name" or "schema,name,type"
+// The first line may be a CSV header naming the columns in one of these orders, it is skipped
+// Functions are named by their signature as in the build list, lines which are not parsed are added to rejected_lines
+PatchList FileHandler::ParseImportText(const QString &text, QStringList &rejected_lines)
+{
+	const auto lines = text.split(QRegExp("\\r\\n|\\n|\\r"));
+	PatchList object_list;
+	auto is_first_line = true;
+
+	for (auto i = 0; i < lines.count(); ++i)
 	{
-		const QString read_string = input.readLine();
+		const auto read_string = lines.at(i).trimmed();
 
-		if (QRegExp("( )*").exactMatch(read_string))
+		if (read_string.isEmpty())
 		{
 			continue;
 		}
 
+		if (is_first_line)
+		{
+			is_first_line = false;
+
+			if (IsCsvHeader(read_string))
+			{
+				continue;
+			}
+		}
+
 		int type = ObjectTypes::type_count;
 		QString schema_name = "";
 		QString name;
 
-		if (QRegExp("([^ ])+ ([^ ])+ (table|sequence|view|trigger|index|function)( )*").exactMatch(read_string))
+		if (ParsePatchListLine(read_string, type, schema_name, name) || ParseCsvLine(read_string, type, schema_name, name))
 		{
-			const auto split_result = read_string.split(" ", QString::SkipEmptyParts);
-			schema_name = split_result.at(0);
-			name = split_result.at(1);
-			type = ObjectTypes::type_names.key(split_result.at(2));
+			object_list.Add(type, schema_name, name);
 		}
 		else
 		{
-			file.close();
-			is_successful = false;
-			return PatchList();
+			rejected_lines.append(QString("Line %1: %2").arg(i + 1).arg(read_string));
 		}
-
-		dependency_list.Add(type, schema_name, name, QStringList());
 	}
 
-	file.close();
-	is_successful = true;
-	return dependency_list;
+	return object_list;
 }
 
 // Getter for patchListName
@@ -235,6 +498,205 @@ QString FileHandler::GetObjectListName()
 	return object_list_name;
 }
 
+// Parses line written in patch list format
+bool FileHandler::ParsePatchListLine(const QString &line, int &type, QString &schema_name, QString &name)
+{
+	if (QRegExp("([^ ])+ ([^ ])+ (table|sequence|view|trigger|index)( )*").exactMatch(line))
+	{
+		const auto split_result = line.split(" ", QString::SkipEmptyParts);
+		schema_name = split_result.at(0);
+		name = split_result.at(1);
+		type = ObjectTypes::type_names.key(split_result.at(2));
+		return true;
+	}
+
+	if (QRegExp("script (.)+").exactMatch(line))
+	{
+		name = line.mid(QString("script ").size()).trimmed();
+		type = ObjectTypes::script;
+		return true;
+	}
+
+	if (QRegExp("([^ ])+ ([^ ])+ function \\( (([^,() ])+ )*\\)( )*").exactMatch(line))
+	{
+		auto split_result = line.split(QRegExp("(\\ |\\(|\\))"), QString::SkipEmptyParts);
+		schema_name = split_result.takeFirst();
+		name = split_result.takeFirst();
+		split_result.pop_front();
+		name += "(" + split_result.join(",") + ")";
+		type = ObjectTypes::function;
+		return true;
+	}
+
+	return false;
+}
+
+// Checks if line is CSV header "type,schema,name" or "schema,name,type", field names are case insensitive
+bool FileHandler::IsCsvHeader(const QString &line)
+{
+	QStringList fields;
+
+	for (const auto &current : SplitCsvLine(line))
+	{
+		fields.append(current.trimmed().toLower());
+	}
+
+	return fields == QStringList({ "type", "schema", "name" }) || fields == QStringList({ "schema", "name", "type" });
+}
+
+// Parses CSV record "type,schema,name", "schema,name,type" or "script,path"
+bool FileHandler::ParseCsvLine(const QString &line, int &type, QString &schema_name, QString &name)
+{
+	const auto fields = SplitCsvLine(line);
+
+	if (fields.count() == 2 && fields.first() == ObjectTypes::type_names.value(ObjectTypes::script) && !fields.last().isEmpty())
+	{
+		type = ObjectTypes::script;
+		name = fields.last();
+		return true;
+	}
+
+	if (fields.count() != 3)
+	{
+		return false;
+	}
+
+	// Type goes first or last
+	const auto type_field = ObjectTypes::type_names.key(fields.first(), ObjectTypes::type_count) != ObjectTypes::type_count ? 0 : 2;
+
+	type = ObjectTypes::type_names.key(fields.at(type_field), ObjectTypes::type_count);
+	schema_name = fields.at(type_field == 0 ? 1 : 0);
+	name = fields.at(type_field == 0 ? 2 : 1);
+
+	if (type == ObjectTypes::type_count || name.isEmpty())
+	{
+		return false;
+	}
+
+	if (type == ObjectTypes::script)
+	{
+		schema_name = "";
+		return true;
+	}
+
+	if (schema_name.isEmpty())
+	{
+		return false;
+	}
+
+	// Spaces are removed as in manual input
+	name.remove(' ');
+
+	if (type == ObjectTypes::function && !name.contains('('))
+	{
+		name += "()";
+	}
+
+	return true;
+}
+
+// Splits CSV record into fields
+// Fields may be quoted, so they can contain commas, quotes inside quoted fields are doubled
+QStringList FileHandler::SplitCsvLine(const QString &line)
+{
+	QStringList fields;
+	QString field;
+	auto is_quoted = false;
+
+	for (auto i = 0; i < line.size(); ++i)
+	{
+		const auto current = line.at(i);
+
+		if (is_quoted)
+		{
+			if (current != '"')
+			{
+				field += current;
+			}
+			else if (i + 1 < line.size() && line.at(i + 1) == '"')
+			{
+				field += current;
+				++i;
+			}
+			else
+			{
+				is_quoted = false;
+			}
+		}
+		else if (current == '"')
+		{
+			is_quoted = true;
+		}
+		else if (current == ',')
+		{
+			fields.append(field.trimmed());
+			field.clear();
+		}
+		else
+		{
+			field += current;
+		}
+	}
+
+	fields.append(field.trimmed());
+	return fields;
+}
+
+// Makes CSV report of patch installation from Installer records
+// Every record is written with type, schema and name of its object, records of unknown rows are written without them
+bool FileHandler::MakeInstallReport(const QString &path, const PatchList &object_list, const QVector<InstallerRecord> &report
+	, QString &error_message)
+{
+	ListFileWriter writer(path);
+
+	if (!writer.Open())
+	{
+		error_message = writer.GetErrorMessage();
+		return false;
+	}
+
+	writer.Write("row,type,schema,name,status,duration_ms,message");
+	writer.EndLine();
+
+	for (const auto &record : report)
+	{
+		const auto is_known = record.row >= 0 && record.row < object_list.Count();
+		writer.Write(QString::number(record.row + 1));
+		writer.Write(',');
+		writer.Write(is_known ? ObjectTypes::type_names.value(object_list.GetType(record.row)) : "");
+		writer.Write(',');
+		writer.Write(is_known ? QuoteCsvField(object_list.GetSchema(record.row)) : "");
+		writer.Write(',');
+		writer.Write(is_known ? QuoteCsvField(object_list.GetName(record.row)) : "");
+		writer.Write(',');
+		writer.Write(InstallerHandler::GetStatusName(record.status));
+		writer.Write(',');
+		writer.Write(QString::number(record.duration));
+		writer.Write(',');
+		writer.Write(QuoteCsvField(record.message));
+		writer.EndLine();
+	}
+
+	if (!writer.Commit())
+	{
+		error_message = writer.GetErrorMessage();
+		return false;
+	}
+
+	return true;
+}
+
+// Quotes CSV field if it contains separators or quotes, quotes are doubled
+QString FileHandler::QuoteCsvField(const QString &field)
+{
+	if (!field.contains(',') && !field.contains('"') && !field.contains('\n'))
+	{
+		return field;
+	}
+
+	return '"' + QString(field).replace("\"", "\"\"") + '"';
+}
+
 // Returns formatted parameters string made from list of parameters
 QString FileHandler::GetParametersString(const QStringList &parameters)
 {
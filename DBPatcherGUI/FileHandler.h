@@ -2,19 +2,30 @@
 
 #include "PatchList.h"
 
+#include <QByteArray>
 #include <QString>
 #include <QDir>
 
+struct InstallerRecord;
+
 // Class operating with patch files
 class FileHandler
 {
 public:
 	FileHandler() = delete;
 	static QDir MakePatchDir(const QString &path, bool &is_successful);
-	static bool MakePatchList(const QString &path, const PatchList &patch_list);
-	static bool MakeDependencyList(const QString &path, const PatchList &dependency_list);
-	static PatchList ParseObjectList(const QString &path, bool &is_successful);
-	static PatchList ParseDependencyList(const QString &path, bool &is_successful);
+	static bool MakePatchList(const QString &path, const PatchList &patch_list, QString &error_message);
+	static bool MakeDependencyList(const QString &path, const PatchList &dependency_list, QString &error_message);
+	static PatchList ParseObjectList(const QString &path, bool &is_successful, QString &error_message);
+	static PatchList ParseDependencyList(const QString &path, bool &is_successful, QString &error_message);
+	static bool MakeManifest(const QString &path, QString &error_message);
+	static bool MakeManifest(const QString &path, const PatchList &object_list, const PatchList &dependency_list
+		, QString &error_message);
+	static bool ParseManifest(const QString &path, PatchList &object_list, PatchList &dependency_list);
+	static PatchList ParseImportFile(const QString &path, QStringList &rejected_lines, bool &is_successful);
+	static PatchList ParseImportText(const QString &text, QStringList &rejected_lines);
+	static bool MakeInstallReport(const QString &path, const PatchList &object_list, const QVector<InstallerRecord> &report
+		, QString &error_message);
 	static QString GetPatchListName();
 	static QString GetDependencyListName();
 	static QString GetObjectListName();
@@ -25,5 +36,17 @@ private:
 	static const QString dependency_list_name;
 	// Name of patch object list file which is created by Builder module
 	static const QString object_list_name;
+	// Name of binary manifest which duplicates object and dependency lists
+	static const QString manifest_name;
+	// Manifest file signature and format version
+	static const QByteArray manifest_magic;
+	static const quint32 manifest_version;
+	// Size of manifest body part hashed at once
+	static const int manifest_hash_block_size;
 	static QString GetParametersString(const QStringList &parameters);
+	static bool ParsePatchListLine(const QString &line, int &type, QString &schema_name, QString &name);
+	static bool ParseCsvLine(const QString &line, int &type, QString &schema_name, QString &name);
+	static bool IsCsvHeader(const QString &line);
+	static QStringList SplitCsvLine(const QString &line);
+	static QString QuoteCsvField(const QString &field);
 };
\ No newline at end of file
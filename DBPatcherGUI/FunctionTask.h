@@ -0,0 +1,22 @@
+#pragma once
+
+#include <QRunnable>
+#include <functional>
+
+// Thread pool task running a function
+class FunctionTask : public QRunnable
+{
+public:
+	FunctionTask(const std::function<void()> &function)
+		: function(function)
+	{
+	}
+
+	void run() override
+	{
+		function();
+	}
+private:
+	// Function run by the task
+	std::function<void()> function;
+};
\ No newline at end of file
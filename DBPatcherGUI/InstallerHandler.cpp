@@ -1,11 +1,18 @@
 #include "InstallerHandler.h"
+#include "ProcessJob.h"
 
 #include <QBitArray>
-#include <QProcess>
 #include <QIODevice>
+#include <QStringList>
+#include <QTextCodec>
 
 const QString InstallerHandler::program = "PatchInstaller_exe.exe";
 QIODevice *InstallerHandler::output_device = nullptr;
+int InstallerHandler::install_timeout = 0;
+int InstallerHandler::check_timeout = 0;
+bool InstallerHandler::is_in_process_check_enabled = true;
+const QByteArray InstallerHandler::record_prefix = "@object\t";
+const QStringList InstallerHandler::status_names = { "installed", "failed", "skipped" };
 
 // Sets new log output device
 void InstallerHandler::SetOutputDevice(QIODevice &new_device)
@@ -13,80 +20,106 @@ void InstallerHandler::SetOutputDevice(QIODevice &new_device)
 	output_device = &new_device;
 }
 
-// Launches and manages patch installation process
-// Returns result of installation
-bool InstallerHandler::InstallPatch(const QString &database, const QString &user, const QString &password,
-	const QString &server, int port, const QString &path)
+// Sets time limits of installation and dependency check in milliseconds, 0 means no limit
+void InstallerHandler::SetTimeouts(int new_install_timeout, int new_check_timeout)
 {
-	const auto connection_info = QString("%1:%2:%3:%4:%5").arg(server)	.arg(port).arg(database).arg(user).arg(password);
-	const QStringList arguments = { connection_info, "install", path };
-
-	QProcess installer_process;
-
-	connect(&installer_process, &QProcess::readyReadStandardError, [&installer_process] ()
-	{
-		if (output_device)
-		{
-			output_device->write(installer_process.readAllStandardError());
-		}
-	});
+	install_timeout = new_install_timeout;
+	check_timeout = new_check_timeout;
+}
 
-	installer_process.start(program, arguments);
+// Enables or disables dependency check inside the application
+void InstallerHandler::SetInProcessCheckEnabled(bool is_enabled)
+{
+	is_in_process_check_enabled = is_enabled;
+}
 
-	if (!installer_process.waitForStarted())
-	{
-		return false;
-	}
+// Checks if dependencies are checked inside the application
+bool InstallerHandler::IsInProcessCheckEnabled()
+{
+	return is_in_process_check_enabled;
+}
 
-	if (!installer_process.waitForFinished() || installer_process.exitCode() != 0)
+// Writes message to log device
+void InstallerHandler::WriteLog(const QString &message)
+{
+	if (output_device)
 	{
-		return false;
+		output_device->write(EncodeOutput(message + '\n'));
 	}
-
-	return true;
 }
 
-// Launches and manages dependency check process
-// Returns result of check as bit array
-QBitArray InstallerHandler::CheckDependencies(const QString &database, const QString &user, const QString &password,
-	const QString &server, int port, const QString &path, bool &is_successful)
+// Makes job running Installer process, its output is written to log device
+// Job is not started, so the caller connects to its signals first
+ProcessJob* InstallerHandler::MakeJob(const QStringList &arguments, int timeout, QObject *parent)
 {
-	const auto connection_info = QString("%1:%2:%3:%4:%5").arg(server).arg(port).arg(database).arg(user).arg(password);
-	const QStringList arguments = { connection_info, "check", path };
+	const auto job = new ProcessJob(program, arguments, parent);
+	job->SetTimeout(timeout);
 
-	QProcess installer_process;
-
-	connect(&installer_process, &QProcess::readyReadStandardError, [&installer_process] ()
+	connect(job, &ProcessJob::OutputReceived, [](const QByteArray &output)
 	{
 		if (output_device)
 		{
-			output_device->write(installer_process.readAllStandardError());
+			output_device->write(output);
 		}
 	});
 
-	QBitArray check_result;
+	return job;
+}
 
-	installer_process.start(program, arguments);
+// Makes job of patch installation
+// Standard output is passed on by lines, records are handled by the owner and other lines are written to log
+ProcessJob* InstallerHandler::InstallPatch(const QString &database, const QString &user, const QString &password,
+	const QString &server, int port, const QString &path, QObject *parent)
+{
+	const auto connection_info = QString("%1:%2:%3:%4:%5").arg(server).arg(port).arg(database).arg(user).arg(password);
+	const QStringList arguments = { connection_info, "install", path };
+	const auto job = MakeJob(arguments, install_timeout, parent);
+	job->SetOutputFramed(true);
 
-	if (!installer_process.waitForStarted())
+	connect(job, &ProcessJob::LineReceived, [](const QByteArray &line)
 	{
-		is_successful = false;
-		return check_result;
-	}
+		InstallerRecord record;
 
-	if (!installer_process.waitForFinished() || installer_process.exitCode() != 0)
-	{
-		is_successful = false;
-		return check_result;
-	}
+		if (!output_device)
+		{
+			return;
+		}
+
+		if (!IsRecord(line))
+		{
+			output_device->write(line + '\n');
+		}
+		else if (ParseRecord(line, record) && record.status == object_failed)
+		{
+			output_device->write(EncodeOutput(QString("Object %1 is not installed: %2\n").arg(record.row + 1).arg(record.message)));
+		}
+	});
 
-	installer_process.setReadChannel(QProcess::ProcessChannel::StandardOutput);
-	QByteArray read_data = installer_process.readAll();
-	check_result.resize(read_data.count());
+	return job;
+}
+
+// Makes job of dependency check
+// Installer writes result of every dependency to standard output as it is checked,
+// so output is streamed to the owner, which parses it by chunks with ParseCheckResult
+ProcessJob* InstallerHandler::CheckDependencies(const QString &database, const QString &user, const QString &password,
+	const QString &server, int port, const QString &path, QObject *parent)
+{
+	const auto connection_info = QString("%1:%2:%3:%4:%5").arg(server).arg(port).arg(database).arg(user).arg(password);
+	const QStringList arguments = { connection_info, "check", path };
+	const auto job = MakeJob(arguments, check_timeout, parent);
+	job->SetOutputStreamed(true);
+	return job;
+}
+
+// Parses output of dependency check, it is a character for every dependency, so any chunk of output is parsed alone
+// Returns result of check as bit array
+QBitArray InstallerHandler::ParseCheckResult(const QByteArray &output, bool &is_successful)
+{
+	QBitArray check_result(output.count());
 
 	for (auto i = 0; i < check_result.count(); ++i)
 	{
-		switch (read_data[i])
+		switch (output[i])
 		{
 			case '0':
 			{
@@ -109,4 +142,50 @@ QBitArray InstallerHandler::CheckDependencies(const QString &database, const QSt
 
 	is_successful = true;
 	return check_result;
+}
+
+// Checks if line of Installer output is a record
+bool InstallerHandler::IsRecord(const QByteArray &line)
+{
+	return line.startsWith(record_prefix);
+}
+
+// Parses record line of Installer output
+// Returns false if the line is not a correct record
+bool InstallerHandler::ParseRecord(const QByteArray &line, InstallerRecord &record)
+{
+	if (!IsRecord(line))
+	{
+		return false;
+	}
+
+	// Message is the last field, so it can contain tabulations
+	const auto fields = line.mid(record_prefix.size()).split('\t');
+
+	if (fields.count() < 3)
+	{
+		return false;
+	}
+
+	auto is_row_correct = false;
+	auto is_duration_correct = false;
+	record.row = fields[0].toInt(&is_row_correct);
+	record.status = status_names.indexOf(QString::fromLatin1(fields[1]));
+	record.duration = fields[2].toLongLong(&is_duration_correct);
+	record.message = fields.count() > 3 ? QString::fromUtf8(line.mid(record_prefix.size() + fields[0].size() + fields[1].size() + fields[2].size() + 3)) : "";
+	return is_row_correct && is_duration_correct && record.status != -1;
+}
+
+// Returns name of object status used in records
+QString InstallerHandler::GetStatusName(int status)
+{
+	return status_names.value(status);
+}
+
+// Encodes application text as module output, so the log device decodes it as Windows-1251 like the rest of the log
+// Codec is found once, local encoding is used if it is not available, as the log device does
+QByteArray InstallerHandler::EncodeOutput(const QString &text)
+{
+	static const auto codec = QTextCodec::codecForName("Windows-1251");
+	return codec ? codec->fromUnicode(text) : text.toLocal8Bit();
 }
\ No newline at end of file
@@ -1,26 +1,72 @@
 #pragma once
 
 #include <QObject>
+#include <QString>
 
 class QBitArray;
-class QString;
+class QByteArray;
 class QIODevice;
+class ProcessJob;
+
+// Record of installation protocol about one patch object
+struct InstallerRecord
+{
+	// Row of object in patch list
+	int row;
+	// Installation status of object
+	int status;
+	// Installation time in milliseconds
+	qint64 duration;
+	// Message of Installer, error text for failed object
+	QString message;
+};
 
 // Class for Installer module process management
+// During installation Installer writes a record line to standard output for every patch object:
+// "@object<TAB>row<TAB>status<TAB>duration in ms<TAB>message" in UTF-8, where row is zero-based index of object in patch list
+// and status is "installed", "failed" or "skipped".
+// Other lines of standard output are written to log
 class InstallerHandler : QObject
 {
 	Q_OBJECT
 
 public:
+	// Installation statuses of patch object
+	enum ObjectStatus
+	{
+		object_installed,
+		object_failed,
+		object_skipped
+	};
+
 	InstallerHandler() = delete;
 	static void SetOutputDevice(QIODevice &new_device);
-	static bool InstallPatch(const QString &database, const QString &user, const QString &password,
-		const QString &server, int port, const QString &path);
-	static QBitArray CheckDependencies(const QString &database, const QString &user, const QString &password,
-		const QString &server, int port, const QString &path, bool &is_successful);
+	static void SetTimeouts(int new_install_timeout, int new_check_timeout);
+	static void SetInProcessCheckEnabled(bool is_enabled);
+	static bool IsInProcessCheckEnabled();
+	static void WriteLog(const QString &message);
+	static ProcessJob* InstallPatch(const QString &database, const QString &user, const QString &password,
+		const QString &server, int port, const QString &path, QObject *parent);
+	static ProcessJob* CheckDependencies(const QString &database, const QString &user, const QString &password,
+		const QString &server, int port, const QString &path, QObject *parent);
+	static QBitArray ParseCheckResult(const QByteArray &output, bool &is_successful);
+	static bool IsRecord(const QByteArray &line);
+	static bool ParseRecord(const QByteArray &line, InstallerRecord &record);
+	static QString GetStatusName(int status);
 private:
 	// Name of Installer module program file
 	const static QString program;
 	// Device for installer log output
 	static QIODevice *output_device;
+	// Time limits of installation and dependency check in milliseconds, 0 if they are unlimited
+	static int install_timeout;
+	static int check_timeout;
+	// Flag showing if dependencies are checked inside the application, Installer check is used as fallback
+	static bool is_in_process_check_enabled;
+	// Beginning of record line
+	static const QByteArray record_prefix;
+	// Names of object statuses in records
+	static const QStringList status_names;
+	static ProcessJob* MakeJob(const QStringList &arguments, int timeout, QObject *parent);
+	static QByteArray EncodeOutput(const QString &text);
 };
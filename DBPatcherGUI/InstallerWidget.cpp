@@ -8,10 +8,17 @@
 #include "ObjectTypes.h"
 #include "DatabaseProvider.h"
 #include "FileHandler.h"
+#include "ProcessJob.h"
+#include "DependencyChecker.h"
+#include "MappedListFile.h"
 
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QBitArray>
+#include <QFileInfo>
+
+const qint64 InstallerWidget::mapped_open_size = 16 * 1024 * 1024;
+const int InstallerWidget::check_batch_size = 4096;
 
 // Widget constructor, taking pointer to parent widget
 // When parent widget is being deleted, all its children are deleted automatically
@@ -19,6 +26,14 @@ InstallerWidget::InstallerWidget(QWidget *parent)
 	: QWidget(parent)
 	, ui(new Ui::InstallerWidget)
 	, is_patch_opened(false)
+	, installer_job(nullptr)
+	, dependency_checker(nullptr)
+	, is_check_enabled(false)
+	, is_install_enabled(false)
+	, failed_object_count(0)
+	, checked_dependency_count(0)
+	, is_check_running(false)
+	, is_check_output_correct(true)
 {
 	ui->setupUi(this);
 
@@ -31,6 +46,8 @@ InstallerWidget::InstallerWidget(QWidget *parent)
 	connect(ui->install_button, &QPushButton::clicked, this, &InstallerWidget::OnInstallButtonClicked);
 	connect(ui->open_patch_button, &QPushButton::clicked, this, &InstallerWidget::OnOpenButtonClicked);
 	connect(ui->dependency_list_widget, &DependencyListWidget::ItemCheckChanged, this, &InstallerWidget::OnItemCheckChanged);
+	connect(ui->patch_list_widget, &PatchListWidget::LineInvalid, this, &InstallerWidget::OnListLineInvalid);
+	connect(ui->dependency_list_widget, &DependencyListWidget::LineInvalid, this, &InstallerWidget::OnListLineInvalid);
 }
 
 // Destructor with ui object deleting
@@ -65,52 +82,81 @@ void InstallerWidget::SetReadyToOpen()
 }
 
 // Fills list widget of patch objects with information from patch 
-bool InstallerWidget::InitPatchList(const QString &path)
+// Large files are mapped and their objects are decoded only when they are shown, incorrect lines are reported then
+// Files which cannot be split into lines by bytes are parsed, mapping errors are not retried by parsing
+bool InstallerWidget::InitPatchList(const QString &path, QString &error_message, PatchList &object_list)
 {
+	const auto file_path = QDir(path).absoluteFilePath(FileHandler::GetObjectListName());
+
+	if (IsOpenedMapped(file_path))
+	{
+		return ui->patch_list_widget->OpenMapped(file_path, error_message);
+	}
+
 	auto is_successful = false;
-	const auto object_list = FileHandler::ParseObjectList(path, is_successful);
+	object_list = FileHandler::ParseObjectList(path, is_successful, error_message);
 
 	if (!is_successful)
 	{
 		return false;		
 	}
 
+	ShowPatchList(object_list);
+	return true;
+}
+
+// Shows patch objects, functions are named by their signature
+void InstallerWidget::ShowPatchList(const PatchList &object_list)
+{
+	PatchList displayed_list;
+	displayed_list.Reserve(object_list.Count());
+
 	for (const auto current : object_list)
 	{
-		const auto type = current->GetType();
-		ui->patch_list_widget->Add(type, current->GetSchema(), current->GetName()
-			+ QString(type == ObjectTypes::function ? "(" + current->GetParameters().join(",") + ")" : ""), false);
+		const auto type = current.GetType();
+		displayed_list.Add(type, current.GetSchema(), current.GetName()
+			+ QString(type == ObjectTypes::function ? "(" + current.GetParameters().join(",") + ")" : ""));
 	}
 
+	ui->patch_list_widget->Add(displayed_list, false);
 	ui->patch_list_widget->scrollToTop();
-	return true;
 }
 
 // Fills list widget of dependencies with information from patch 
-bool InstallerWidget::InitDependencyList(const QString &path)
+// Large files are mapped as in InitPatchList
+bool InstallerWidget::InitDependencyList(const QString &path, QString &error_message, PatchList &dependency_list)
 {
-	auto is_successful = false;
-	const auto dependency_list = FileHandler::ParseDependencyList(path, is_successful);
+	const auto file_path = QDir(path).absoluteFilePath(FileHandler::GetDependencyListName());
 
-	if(!is_successful)
+	if (IsOpenedMapped(file_path))
 	{
-		return false;
+		return ui->dependency_list_widget->OpenMapped(file_path, error_message);
 	}
 
-	for (const auto current : dependency_list)
+	auto is_successful = false;
+	dependency_list = FileHandler::ParseDependencyList(path, is_successful, error_message);
+
+	if(!is_successful)
 	{
-		ui->dependency_list_widget->Add(current->GetType(), current->GetSchema(), current->GetName());
+		return false;
 	}
 
+	ui->dependency_list_widget->Add(dependency_list);
 	return true;
 }
 
+// Checks if list file is large enough to be mapped and can be split into lines by bytes
+bool InstallerWidget::IsOpenedMapped(const QString &file_path)
+{
+	return QFileInfo(file_path).size() >= mapped_open_size && MappedListFile::CanMap(file_path);
+}
+
 // Sets all interface elements affected by patch opening to default state
 void InstallerWidget::ClearCurrentPatch()
 {
 	patch_dir = QDir();
 	ui->dependency_list_widget->Clear();
-	ui->patch_list_widget->clear();
+	ui->patch_list_widget->Clear();
 	ui->patch_path_edit->setPlaceholderText("Patch folder path");
 	ui->patch_path_edit->setEnabled(true);
 	ui->check_button->setDisabled(true);
@@ -179,25 +225,42 @@ void InstallerWidget::OnOpenButtonClicked()
 		return;
 	}
 
-	if (!InitPatchList(patch_dir.absolutePath()))
+	QString error_message;
+	PatchList object_list;
+	PatchList dependency_list;
+
+	// Manifest replaces parsing of text lists while they are not changed
+	// It is read in whole, so it is not used when a list is large enough to be mapped, as mapping shows it at once
+	const auto is_any_mapped = IsOpenedMapped(patch_dir.absoluteFilePath(FileHandler::GetObjectListName()))
+		|| IsOpenedMapped(patch_dir.absoluteFilePath(FileHandler::GetDependencyListName()));
+
+	if (!is_any_mapped && FileHandler::ParseManifest(patch_dir.absolutePath(), object_list, dependency_list))
 	{
-		QApplication::beep();
-		QMessageBox::warning(this, "Open error", "Incorrect file " + FileHandler::GetObjectListName()
-			, QMessageBox::Ok, QMessageBox::Ok);
-		ClearCurrentPatch();
-		return;
+		ShowPatchList(object_list);
+		ui->dependency_list_widget->Add(dependency_list);
 	}
-
-	if (!InitDependencyList(patch_dir.absolutePath()))
+	else
 	{
-		QApplication::beep();
-		QMessageBox::warning(this, "Open error", "Incorrect file " + FileHandler::GetDependencyListName()
-			, QMessageBox::Ok, QMessageBox::Ok);
-		ClearCurrentPatch();
-		return;
+		if (!InitPatchList(patch_dir.absolutePath(), error_message, object_list))
+		{
+			QApplication::beep();
+			QMessageBox::warning(this, "Open error", "Incorrect file " + FileHandler::GetObjectListName() + ": " + error_message
+				, QMessageBox::Ok, QMessageBox::Ok);
+			ClearCurrentPatch();
+			return;
+		}
+
+		if (!InitDependencyList(patch_dir.absolutePath(), error_message, dependency_list))
+		{
+			QApplication::beep();
+			QMessageBox::warning(this, "Open error", "Incorrect file " + FileHandler::GetDependencyListName() + ": " + error_message
+				, QMessageBox::Ok, QMessageBox::Ok);
+			ClearCurrentPatch();
+			return;
+		}
 	}
 
-	if (ui->dependency_list_widget->topLevelItemCount() == 0)
+	if (ui->dependency_list_widget->Count() == 0)
 	{
 		ui->install_info_label->setText("The patch has no dependencies");
 		ui->install_button->setEnabled(true);
@@ -217,47 +280,43 @@ void InstallerWidget::OnOpenButtonClicked()
 }
 
 // Handles check button click
-// Launches dependency check and shows information about its result
+// Launches dependency check, its result is shown when it is finished
+// While check is running, the button cancels it
 void InstallerWidget::OnCheckButtonClicked()
 {
-	if (!CheckConnection())
+	if (installer_job || dependency_checker)
 	{
+		CancelJob();
 		return;
 	}
 
-	if (StartDependencyCheck())
+	if (!CheckConnection())
 	{
-		ui->check_button->setDisabled(true);
+		return;
+	}
 
-		QApplication::beep();
+	QString error_message;
 
-		if (!ui->dependency_list_widget->GetAreAllSatisfied())
-		{
-			QMessageBox::warning(this, "Verification completed"
-				, "Verification completed. Not all dependencies are found. If you want to continue the installation, "
-				"confirm all dependencies manually in the list"
-				, QMessageBox::Ok, QMessageBox::Ok);
-		}
-		else
-		{
-			QMessageBox::information(this, "Verification completed"
-				, "Verification completed. All dependencies found. The patch can be installed safely... almost safely :)"
-				, QMessageBox::Ok, QMessageBox::Ok);
-		}
-	}
-	else
+	if (!StartDependencyCheck(InstallerHandler::IsInProcessCheckEnabled(), error_message))
 	{
 		QApplication::beep();
 		QMessageBox::warning(this, "Check error"
-			, "Error occured. See log for details"
+			, "Error occured: " + error_message
 			, QMessageBox::Ok, QMessageBox::Ok);
 	}
 }
 
 // Handles install button click
-// Launches patch installation and shows information about its result
+// Launches patch installation, its result is shown when it is finished
+// While installation is running, the button cancels it
 void InstallerWidget::OnInstallButtonClicked()
 {
+	if (installer_job || dependency_checker)
+	{
+		CancelJob();
+		return;
+	}
+
 	if (!CheckConnection())
 	{
 		return;
@@ -277,29 +336,21 @@ void InstallerWidget::OnInstallButtonClicked()
 		}
 	}
 
-	if (InstallerHandler::InstallPatch(DatabaseProvider::Database()
+	const auto job = InstallerHandler::InstallPatch(DatabaseProvider::Database()
 		, DatabaseProvider::User(), DatabaseProvider::Password(), DatabaseProvider::Host()
-		, DatabaseProvider::Port(), patch_dir.absolutePath()))
-	{
-		QApplication::beep();
-		QMessageBox::information(this, "Installation completed"
-			, "Installation completed. See log for details"
-			, QMessageBox::Ok, QMessageBox::Ok);
-	}
-	else
-	{
-		QApplication::beep();
-		QMessageBox::warning(this, "Installation error"
-			, "Error occured. See log for details"
-			, QMessageBox::Ok, QMessageBox::Ok);
-	}
+		, DatabaseProvider::Port(), patch_dir.absolutePath(), this);
+	install_report.clear();
+	failed_object_count = 0;
+	connect(job, &ProcessJob::LineReceived, this, &InstallerWidget::OnInstallerLineReceived);
+	connect(job, &ProcessJob::Finished, this, &InstallerWidget::OnInstallationFinished);
+	StartJob(job, ui->install_button, "Installing...");
 }
 
 // Handles amount of checked dependencies change
 // Shows appropriate information and enables install option if all dependencies are checked
 void InstallerWidget::OnItemCheckChanged()
 {
-	if (ui->dependency_list_widget->GetCheckedCount() == ui->dependency_list_widget->topLevelItemCount())
+	if (ui->dependency_list_widget->GetCheckedCount() == ui->dependency_list_widget->Count())
 	{
 		if (!ui->dependency_list_widget->GetAreAllSatisfied())
 		{
@@ -319,6 +370,15 @@ void InstallerWidget::OnItemCheckChanged()
 	}
 }
 
+// Handles incorrect line of mapped list found when it is shown
+// Lines of large lists are not parsed on opening, so the error is shown once the line is decoded
+void InstallerWidget::OnListLineInvalid(const QString &error_message)
+{
+	QApplication::beep();
+	QMessageBox::warning(this, "Patch error", "Incorrect line in patch list: " + error_message
+		, QMessageBox::Ok, QMessageBox::Ok);
+}
+
 // Handles start of disconnection from database
 void InstallerWidget::OnDisconnectionStarted()
 {
@@ -327,31 +387,400 @@ void InstallerWidget::OnDisconnectionStarted()
 		return;
 	}
 
+	// Check inside the application uses pooled connections, which are closed, so it is stopped
+	if (dependency_checker)
+	{
+		dependency_checker->Cancel();
+	}
+
 	ui->dependency_list_widget->ClearCheck();
+
+	// Running Installer job is not stopped, as it has its own connection, so the state is restored when it is finished
+	if (installer_job)
+	{
+		is_check_enabled = true;
+		is_install_enabled = false;
+		saved_info_text = "";
+		return;
+	}
+
 	ui->check_button->setEnabled(true);
 	ui->install_button->setDisabled(true);
 	ui->install_info_label->setText("");
 }
 
-bool InstallerWidget::StartDependencyCheck()
+// Launches dependency check inside the application if it is possible, otherwise by Installer
+// Returns false if check is not started
+bool InstallerWidget::StartDependencyCheck(bool is_in_process, QString &error_message)
 {
-	PatchList dependency_list;
+	PatchList dependencies;
 
-	for (auto i = 0; i < ui->dependency_list_widget->topLevelItemCount(); ++i)
+	if (is_in_process)
 	{
-		const auto current_item = ui->dependency_list_widget->topLevelItem(i);
-		dependency_list.Add(current_item->data(PatchListWidget::ColumnIndexes::type_column, Qt::UserRole).toInt()
-			, current_item->text(PatchListWidget::ColumnIndexes::schema_column)
-			, current_item->text(PatchListWidget::ColumnIndexes::name_column), QStringList());
+		dependencies = ui->dependency_list_widget->GetObjects();
+		is_in_process = DependencyChecker::CanCheck(dependencies);
 	}
 
-	if (!FileHandler::MakeDependencyList(patch_dir.absolutePath(), dependency_list))
+	// Mapped list is checked in file order even if it is sorted, so the file is not rewritten, which is not possible while it is mapped
+	if (!is_in_process && !ui->dependency_list_widget->IsMapped() && !WriteDependencyList(error_message))
 	{
+		error_message = FileHandler::GetDependencyListName() + " is not written: " + error_message;
 		return false;
 	}
 
-	auto is_successful = false;
-	const auto check_result = InstallerHandler::CheckDependencies(DatabaseProvider::Database(), DatabaseProvider::User(), DatabaseProvider::Password()
-		, DatabaseProvider::Host(), DatabaseProvider::Port(), patch_dir.absolutePath(), is_successful);
-	return is_successful && ui->dependency_list_widget->SetCheckStatus(check_result);
+	// Results are shown in rows as they come, so the previous ones are cleared
+	ui->dependency_list_widget->ClearCheck();
+	pending_check_output.clear();
+	checked_dependency_count = 0;
+	is_check_running = true;
+	is_check_output_correct = true;
+
+	if (is_in_process)
+	{
+		dependency_checker = new DependencyChecker(this);
+		connect(dependency_checker, &DependencyChecker::ResultsReady, this, &InstallerWidget::OnCheckResultsReady);
+		connect(dependency_checker, &DependencyChecker::Progress, this, &InstallerWidget::OnJobProgress);
+		connect(dependency_checker, &DependencyChecker::Finished, this, &InstallerWidget::OnDependencyCheckFinished);
+		SetJobRunning(ui->check_button, "Checking dependencies...");
+		dependency_checker->Start(dependencies);
+		return true;
+	}
+
+	const auto job = InstallerHandler::CheckDependencies(DatabaseProvider::Database(), DatabaseProvider::User(), DatabaseProvider::Password()
+		, DatabaseProvider::Host(), DatabaseProvider::Port(), patch_dir.absolutePath(), this);
+	connect(job, &ProcessJob::StandardOutputReceived, this, &InstallerWidget::OnCheckOutputReceived);
+	connect(job, &ProcessJob::Finished, this, &InstallerWidget::OnDependencyCheckFinished);
+	StartJob(job, ui->check_button, "Checking dependencies...");
+	return true;
+}
+
+// Writes dependency list in list order for Installer check
+// Manifest describes the rewritten file, so it is updated if it was up to date, otherwise the next opening parses the lists
+bool InstallerWidget::WriteDependencyList(QString &error_message)
+{
+	PatchList object_list;
+	PatchList manifest_dependency_list;
+	const auto has_manifest = FileHandler::ParseManifest(patch_dir.absolutePath(), object_list, manifest_dependency_list);
+	const auto dependency_list = ui->dependency_list_widget->GetObjects();
+
+	if (!FileHandler::MakeDependencyList(patch_dir.absolutePath(), dependency_list, error_message))
+	{
+		return false;
+	}
+
+	QString manifest_error_message;
+
+	if (has_manifest && !FileHandler::MakeManifest(patch_dir.absolutePath(), object_list, dependency_list, manifest_error_message))
+	{
+		InstallerHandler::WriteLog("Manifest is not updated: " + manifest_error_message);
+	}
+
+	return true;
+}
+
+// Starts Installer job and switches interface to running state
+void InstallerWidget::StartJob(ProcessJob *job, QPushButton *job_button, const QString &text)
+{
+	installer_job = job;
+	SetJobRunning(job_button, text);
+	connect(job, &ProcessJob::Progress, this, &InstallerWidget::OnJobProgress);
+	job->Start();
+}
+
+// Switches interface to running state, saving the current one
+// Patch can not be closed while job is running, and button of the job cancels it
+void InstallerWidget::SetJobRunning(QPushButton *job_button, const QString &text)
+{
+	job_text = text;
+	saved_info_text = ui->install_info_label->text();
+	is_check_enabled = ui->check_button->isEnabled();
+	is_install_enabled = ui->install_button->isEnabled();
+
+	ui->open_patch_button->setDisabled(true);
+	ui->dependency_list_widget->setDisabled(true);
+	ui->check_button->setDisabled(true);
+	ui->install_button->setDisabled(true);
+	ui->install_info_label->setText(job_text);
+	job_button->setText("Cancel");
+	job_button->setIcon(QIcon(":/images/close.svg"));
+	job_button->setEnabled(true);
+}
+
+// Cancels running job, its finish handler is called as usual
+void InstallerWidget::CancelJob()
+{
+	if (dependency_checker)
+	{
+		dependency_checker->Cancel();
+	}
+	else if (installer_job)
+	{
+		installer_job->Cancel();
+	}
+}
+
+// Deletes finished job and restores interface state
+void InstallerWidget::FinishJob()
+{
+	if (installer_job)
+	{
+		installer_job->deleteLater();
+		installer_job = nullptr;
+	}
+
+	if (dependency_checker)
+	{
+		dependency_checker->deleteLater();
+		dependency_checker = nullptr;
+	}
+
+	is_check_running = false;
+
+	ui->open_patch_button->setEnabled(true);
+	ui->dependency_list_widget->setEnabled(true);
+	ui->check_button->setText("Check");
+	ui->check_button->setIcon(QIcon(":/images/test.svg"));
+	ui->check_button->setEnabled(is_check_enabled);
+	ui->install_button->setText("Install");
+	ui->install_button->setIcon(QIcon(":/images/install.svg"));
+	ui->install_button->setEnabled(is_install_enabled);
+	ui->install_info_label->setText(saved_info_text);
+}
+
+// Handles Installer job progress report
+// Dependency check shows pending results and amount of checked dependencies,
+// installation records show amount of processed objects and time of the last one,
+// without them elapsed time and amount of log lines are shown
+void InstallerWidget::OnJobProgress(int output_line_count, qint64 elapsed_time)
+{
+	if (is_check_running)
+	{
+		ApplyCheckOutput();
+		ui->install_info_label->setText(QString("%1 %2 of %3, %4 s").arg(job_text).arg(checked_dependency_count)
+			.arg(ui->dependency_list_widget->Count()).arg(elapsed_time / 1000));
+		return;
+	}
+
+	if (install_report.isEmpty())
+	{
+		ui->install_info_label->setText(QString("%1 %2 s, %3 log lines").arg(job_text).arg(elapsed_time / 1000).arg(output_line_count));
+		return;
+	}
+
+	const auto &last_record = install_report.last();
+	ui->install_info_label->setText(QString("%1 %2 of %3 objects (%4 failed), %5: %6 ms, %7 s").arg(job_text)
+		.arg(install_report.count()).arg(ui->patch_list_widget->Count()).arg(failed_object_count)
+		.arg(ui->patch_list_widget->GetName(last_record.row)).arg(last_record.duration).arg(elapsed_time / 1000));
+}
+
+// Handles line of Installer output during installation
+// Keeps installation records for progress and report
+void InstallerWidget::OnInstallerLineReceived(const QByteArray &line)
+{
+	InstallerRecord record;
+
+	// Record of unknown row can not be shown with its object, so it is skipped
+	if (!InstallerHandler::ParseRecord(line, record) || record.row < 0 || record.row >= ui->patch_list_widget->Count())
+	{
+		return;
+	}
+
+	install_report.append(record);
+
+	if (record.status == InstallerHandler::object_failed)
+	{
+		++failed_object_count;
+	}
+}
+
+// Asks for file name and saves installation report as CSV
+void InstallerWidget::ExportInstallReport()
+{
+	const auto path = QFileDialog::getSaveFileName(this, "Export installation report", patch_dir.absoluteFilePath("InstallReport.csv")
+		, "CSV (*.csv)");
+
+	if (path.isEmpty())
+	{
+		return;
+	}
+
+	QString error_message;
+
+	if (!FileHandler::MakeInstallReport(path, ui->patch_list_widget->GetObjects(), install_report, error_message))
+	{
+		QApplication::beep();
+		QMessageBox::warning(this, "Export error", "Report is not saved to " + path + ": " + error_message
+			, QMessageBox::Ok, QMessageBox::Ok);
+	}
+}
+
+// Handles chunk of dependency check output
+// Results are shown by batches, so the view is not updated for every chunk
+void InstallerWidget::OnCheckOutputReceived(const QByteArray &output)
+{
+	pending_check_output.append(output);
+
+	if (pending_check_output.size() >= check_batch_size)
+	{
+		ApplyCheckOutput();
+	}
+}
+
+// Shows pending dependency check results in the list
+// Incorrect output stops the check, as the rest of results can not be matched with rows
+void InstallerWidget::ApplyCheckOutput()
+{
+	if (pending_check_output.isEmpty() || !is_check_output_correct)
+	{
+		return;
+	}
+
+	auto is_parsed = false;
+	const auto check_result = InstallerHandler::ParseCheckResult(pending_check_output, is_parsed);
+	pending_check_output.clear();
+
+	if (!is_parsed || !ui->dependency_list_widget->SetCheckStatus(checked_dependency_count, check_result))
+	{
+		is_check_output_correct = false;
+
+		if (installer_job)
+		{
+			installer_job->Cancel();
+		}
+
+		return;
+	}
+
+	checked_dependency_count += check_result.count();
+}
+
+// Handles chunk of results of dependency check inside the application
+// Chunks are large, so they are shown at once
+void InstallerWidget::OnCheckResultsReady(int first_row, const QBitArray &check_result)
+{
+	if (!is_check_output_correct)
+	{
+		return;
+	}
+
+	if (!ui->dependency_list_widget->SetCheckStatus(first_row, check_result))
+	{
+		is_check_output_correct = false;
+		dependency_checker->Cancel();
+		return;
+	}
+
+	checked_dependency_count += check_result.count();
+}
+
+// Handles dependency check finish
+// Shows the rest of results in the list and information about check
+// Failed check inside the application is repeated by Installer, cancelled check only restores the interface
+void InstallerWidget::OnDependencyCheckFinished(bool is_successful, const QString &error_message)
+{
+	// Check with incorrect output is cancelled too, but it is reported as failed
+	const auto is_cancelled = is_check_output_correct && (dependency_checker ? dependency_checker->IsCancelled()
+		: installer_job && installer_job->GetStatus() == ProcessJob::cancelled);
+	const auto is_fallback_needed = dependency_checker && !is_successful && !is_cancelled;
+	auto check_error_message = error_message;
+
+	if (!is_cancelled)
+	{
+		ApplyCheckOutput();
+	}
+
+	FinishJob();
+
+	// Check is cancelled by user or by disconnection, so its partial results are dropped without a warning
+	if (is_cancelled)
+	{
+		ui->dependency_list_widget->ClearCheck();
+		ui->check_button->setEnabled(true);
+		ui->install_button->setDisabled(true);
+		ui->install_info_label->setText("");
+		return;
+	}
+
+	if (is_fallback_needed)
+	{
+		InstallerHandler::WriteLog("Dependency check in application failed: " + error_message + ". Checking by Installer");
+		ui->dependency_list_widget->ClearCheck();
+
+		if (StartDependencyCheck(false, check_error_message))
+		{
+			return;
+		}
+	}
+
+	if (is_successful && checked_dependency_count != ui->dependency_list_widget->Count())
+	{
+		is_check_output_correct = false;
+	}
+
+	if (is_successful && is_check_output_correct)
+	{
+		// List widget does not report partial results, so dependent interface elements are updated once here
+		OnItemCheckChanged();
+		ui->check_button->setDisabled(true);
+
+		QApplication::beep();
+
+		if (!ui->dependency_list_widget->GetAreAllSatisfied())
+		{
+			QMessageBox::warning(this, "Verification completed"
+				, "Verification completed. Not all dependencies are found. If you want to continue the installation, "
+				"confirm all dependencies manually in the list"
+				, QMessageBox::Ok, QMessageBox::Ok);
+		}
+		else
+		{
+			QMessageBox::information(this, "Verification completed"
+				, "Verification completed. All dependencies found. The patch can be installed safely... almost safely :)"
+				, QMessageBox::Ok, QMessageBox::Ok);
+		}
+	}
+	else
+	{
+		// Partial results are dropped, so dependencies can not be confirmed manually
+		ui->dependency_list_widget->ClearCheck();
+		ui->install_button->setDisabled(true);
+		ui->install_info_label->setText("");
+		QApplication::beep();
+		QMessageBox::warning(this, "Check error"
+			, (is_check_output_correct ? "Error occured: " + check_error_message : QString("Error occured: incorrect check result")) + ". See log for details"
+			, QMessageBox::Ok, QMessageBox::Ok);
+	}
+}
+
+// Handles patch installation finish
+// Shows information about its result
+// If Installer has written installation records, their summary is shown and report can be exported
+void InstallerWidget::OnInstallationFinished(bool is_successful, const QString &error_message)
+{
+	FinishJob();
+	QApplication::beep();
+
+	auto text = is_successful ? QString("Installation completed.") : "Error occured: " + error_message + ".";
+	qint64 total_duration = 0;
+
+	for (const auto &record : install_report)
+	{
+		total_duration += record.duration;
+	}
+
+	if (!install_report.isEmpty())
+	{
+		text += QString(" Processed objects: %1 of %2, failed: %3, installation time: %4 s.").arg(install_report.count())
+			.arg(ui->patch_list_widget->Count()).arg(failed_object_count).arg(total_duration / 1000.0, 0, 'f', 1);
+	}
+
+	QMessageBox message_box(is_successful ? QMessageBox::Information : QMessageBox::Warning
+		, is_successful ? "Installation completed" : "Installation error", text + " See log for details", QMessageBox::Ok, this);
+	const auto export_button = install_report.isEmpty() ? nullptr : message_box.addButton("Export report...", QMessageBox::ActionRole);
+	message_box.exec();
+
+	if (export_button && message_box.clickedButton() == export_button)
+	{
+		ExportInstallReport();
+	}
 }
\ No newline at end of file
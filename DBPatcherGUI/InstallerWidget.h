@@ -2,6 +2,14 @@
 
 #include <QWidget>
 #include <QDir>
+#include <QVector>
+
+class PatchList;
+struct InstallerRecord;
+class ProcessJob;
+class DependencyChecker;
+class QBitArray;
+class QPushButton;
 
 // Namespace required by Qt for loading .ui form file
 namespace Ui
@@ -25,12 +33,47 @@ private:
 	QDir patch_dir;
 	// Flag showing if patch is opened
 	bool is_patch_opened;
-	bool InitPatchList(const QString &path);
-	bool InitDependencyList(const QString &path);
+	// Size of list file starting from which it is mapped and decoded as it is shown
+	static const qint64 mapped_open_size;
+	// Running Installer job, null if installation or check is not started
+	ProcessJob *installer_job;
+	// Running dependency check inside the application, null if it is not started
+	DependencyChecker *dependency_checker;
+	// Text shown with job progress
+	QString job_text;
+	// Interface state saved while job is running
+	QString saved_info_text;
+	bool is_check_enabled;
+	bool is_install_enabled;
+	// Records of Installer about installed objects
+	QVector<InstallerRecord> install_report;
+	// Amount of objects which are not installed
+	int failed_object_count;
+	// Dependency check output which is not shown yet
+	QByteArray pending_check_output;
+	// Amount of dependencies with shown check result
+	int checked_dependency_count;
+	// Flag showing if running job is dependency check
+	bool is_check_running;
+	// Flag showing if dependency check output is correct so far
+	bool is_check_output_correct;
+	// Amount of check results starting from which they are shown at once, smaller batches wait for progress report
+	static const int check_batch_size;
+	bool InitPatchList(const QString &path, QString &error_message, PatchList &object_list);
+	bool InitDependencyList(const QString &path, QString &error_message, PatchList &dependency_list);
+	void ShowPatchList(const PatchList &object_list);
 	void ClearCurrentPatch();
 	void SetReadyToOpen();
 	bool CheckConnection();
-	bool StartDependencyCheck();
+	bool StartDependencyCheck(bool is_in_process, QString &error_message);
+	bool WriteDependencyList(QString &error_message);
+	void StartJob(ProcessJob *job, QPushButton *job_button, const QString &text);
+	void SetJobRunning(QPushButton *job_button, const QString &text);
+	void CancelJob();
+	void FinishJob();
+	void ExportInstallReport();
+	void ApplyCheckOutput();
+	static bool IsOpenedMapped(const QString &file_path);
 signals:
 	void ConnectionRequested();
 public slots:
@@ -40,4 +83,11 @@ private slots:
 	void OnCheckButtonClicked();
 	void OnInstallButtonClicked();
 	void OnItemCheckChanged();
+	void OnListLineInvalid(const QString &error_message);
+	void OnJobProgress(int output_line_count, qint64 elapsed_time);
+	void OnDependencyCheckFinished(bool is_successful, const QString &error_message);
+	void OnInstallationFinished(bool is_successful, const QString &error_message);
+	void OnInstallerLineReceived(const QByteArray &line);
+	void OnCheckOutputReceived(const QByteArray &output);
+	void OnCheckResultsReady(int first_row, const QBitArray &check_result);
 };
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "LineFramer.h"
+
+const int LineFramer::max_line_length = 1024 * 1024;
+
+// Constructor
+LineFramer::LineFramer()
+{
+}
+
+// Adds chunk of output and returns lines completed by it without line breaks
+// Carriage returns of Windows line breaks are dropped
+QList<QByteArray> LineFramer::Append(const QByteArray &chunk)
+{
+	QList<QByteArray> lines;
+	auto line_start = 0;
+	auto line_end = -1;
+
+	while ((line_end = chunk.indexOf('\n', line_start)) != -1)
+	{
+		auto line = rest.isEmpty() ? chunk.mid(line_start, line_end - line_start) : rest + chunk.mid(line_start, line_end - line_start);
+		rest.clear();
+
+		if (line.endsWith('\r'))
+		{
+			line.chop(1);
+		}
+
+		lines.append(line);
+		line_start = line_end + 1;
+	}
+
+	rest.append(chunk.mid(line_start));
+
+	if (rest.size() >= max_line_length)
+	{
+		lines.append(TakeRest());
+	}
+
+	return lines;
+}
+
+// Returns incomplete line, it is called when output is finished
+QByteArray LineFramer::TakeRest()
+{
+	auto line = rest;
+	rest.clear();
+
+	if (line.endsWith('\r'))
+	{
+		line.chop(1);
+	}
+
+	return line;
+}
+
+// Drops incomplete line
+void LineFramer::Clear()
+{
+	rest.clear();
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+
+// Class assembling lines from chunks of process output
+// Chunks are cut by the pipe at any byte, so the incomplete last line of a chunk is kept till the next one
+class LineFramer
+{
+public:
+	LineFramer();
+	QList<QByteArray> Append(const QByteArray &chunk);
+	QByteArray TakeRest();
+	void Clear();
+private:
+	// Beginning of incomplete line
+	QByteArray rest;
+	// Length of incomplete line starting from which it is passed on as a line, so output without line breaks does not grow it endlessly
+	static const int max_line_length;
+};
\ No newline at end of file
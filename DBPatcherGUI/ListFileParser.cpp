@@ -0,0 +1,298 @@
+#include "ListFileParser.h"
+#include "ObjectTypes.h"
+
+#include <QFile>
+#include <QTextCodec>
+#include <QTextDecoder>
+#include <memory>
+
+const int ListFileParser::block_size = 1 << 20;
+
+// Constructor
+ListFileParser::ListFileParser(Formats format)
+	: format(format)
+	, line_number(0)
+{
+}
+
+// Returns objects parsed from file
+// Text is decoded block by block, lines are parsed as soon as they are complete
+PatchList ListFileParser::Parse(const QString &path, bool &is_successful)
+{
+	objects.Clear();
+	line_number = 0;
+	error_message.clear();
+	QFile file(path);
+
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		error_message = file.errorString();
+		is_successful = false;
+		return PatchList();
+	}
+
+	objects.Reserve(static_cast<int>(file.size() / 32));
+	std::unique_ptr<QTextDecoder> decoder;
+	QString text;
+
+	while (!file.atEnd())
+	{
+		const auto block = file.read(block_size);
+
+		// Byte order mark is detected as QTextStream does it, files without it are read in local encoding
+		if (!decoder)
+		{
+			decoder.reset(QTextCodec::codecForUtfText(block, QTextCodec::codecForLocale())->makeDecoder());
+		}
+
+		text.append(decoder->toUnicode(block));
+		auto line_begin = 0;
+
+		for (auto line_end = text.indexOf('\n'); line_end != -1; line_end = text.indexOf('\n', line_begin))
+		{
+			if (!ParseLine(text, line_begin, line_end))
+			{
+				is_successful = false;
+				return PatchList();
+			}
+
+			line_begin = line_end + 1;
+		}
+
+		text.remove(0, line_begin);
+	}
+
+	if (!text.isEmpty() && !ParseLine(text, 0, text.size()))
+	{
+		is_successful = false;
+		return PatchList();
+	}
+
+	is_successful = true;
+	return objects;
+}
+
+// Getter for error_message
+QString ListFileParser::GetErrorMessage() const
+{
+	return error_message;
+}
+
+// Parses line of file and adds its object to the list
+// Empty lines and lines of spaces are skipped
+bool ListFileParser::ParseLine(const QString &text, int begin, int end)
+{
+	++line_number;
+
+	if (!Tokenize(text, begin, end))
+	{
+		return true;
+	}
+
+	if (!ParseTokens(text, begin, end, current_row))
+	{
+		return false;
+	}
+
+	objects.Add(current_row.type, current_row.schema, current_row.name, current_row.parameters);
+	return true;
+}
+
+// Parses a single line, used to decode rows of mapped file on demand
+bool ListFileParser::ParseRow(const QString &line, int line_number, ListFileRow &row)
+{
+	this->line_number = line_number;
+	error_message.clear();
+	auto end = line.size();
+
+	if (!Tokenize(line, 0, end))
+	{
+		return Fail(1, "object expected");
+	}
+
+	return ParseTokens(line, 0, end, row);
+}
+
+// Splits line into tokens separated by spaces, returns false if there are no tokens
+// Line end is moved before carriage return
+bool ListFileParser::Tokenize(const QString &text, int begin, int &end)
+{
+	if (end > begin && text.at(end - 1) == '\r')
+	{
+		--end;
+	}
+
+	tokens.clear();
+	auto token_begin = -1;
+
+	for (auto i = begin; i <= end; ++i)
+	{
+		if (i == end || text.at(i) == ' ')
+		{
+			if (token_begin != -1)
+			{
+				tokens.append(qMakePair(token_begin, i - token_begin));
+				token_begin = -1;
+			}
+		}
+		else if (token_begin == -1)
+		{
+			token_begin = i;
+		}
+	}
+
+	return !tokens.isEmpty();
+}
+
+// Parses tokens of line by file format
+bool ListFileParser::ParseTokens(const QString &text, int begin, int end, ListFileRow &row)
+{
+	row.parameters.clear();
+
+	switch (format)
+	{
+		case object_list_format:
+		{
+			return ParseObjectLine(text, begin, end, row);
+		}
+		case dependency_list_format:
+		{
+			return ParseDependencyLine(text, begin, end, row);
+		}
+		default:
+		{
+			return false;
+		}
+	}
+}
+
+// Parses line of object list: "schema name type", "script name" or "schema name function ( parameters )"
+bool ListFileParser::ParseObjectLine(const QString &text, int begin, int end, ListFileRow &row)
+{
+	if (tokens.count() == 3 && TokenType(text, 2) != ObjectTypes::function)
+	{
+		const auto type = TokenType(text, 2);
+
+		if (type == ObjectTypes::type_count || type == ObjectTypes::script)
+		{
+			return Fail(tokens.at(2).first - begin + 1, "unknown object type \"" + Token(text, 2) + "\"");
+		}
+
+		row = ListFileRow{ type, Token(text, 0), Token(text, 1), QStringList() };
+		return true;
+	}
+
+	if (IsToken(text, 0, ObjectTypes::type_names.value(ObjectTypes::script)) && tokens.count() <= 2)
+	{
+		if (tokens.count() == 1)
+		{
+			return Fail(end - begin + 1, "script name expected");
+		}
+
+		row = ListFileRow{ ObjectTypes::script, "", Token(text, 1), QStringList() };
+		return true;
+	}
+
+	if (tokens.count() < 3)
+	{
+		return Fail(end - begin + 1, "schema, name and type expected");
+	}
+
+	if (!IsToken(text, 2, ObjectTypes::type_names.value(ObjectTypes::function)))
+	{
+		return Fail(tokens.at(3).first - begin + 1, "unexpected text after object type");
+	}
+
+	if (tokens.count() < 4 || !IsToken(text, 3, "("))
+	{
+		return Fail((tokens.count() < 4 ? end : tokens.at(3).first) - begin + 1, "\"(\" expected");
+	}
+
+	const auto last = tokens.count() - 1;
+
+	if (last == 3 || !IsToken(text, last, ")"))
+	{
+		return Fail(end - begin + 1, "\")\" expected");
+	}
+
+	for (auto i = 4; i < last; ++i)
+	{
+		const auto &token = tokens.at(i);
+
+		for (auto j = token.first; j < token.first + token.second; ++j)
+		{
+			const auto current = text.at(j);
+
+			if (current == ',' || current == '(' || current == ')')
+			{
+				return Fail(j - begin + 1, QString("unexpected \"%1\" in parameter type").arg(current));
+			}
+		}
+
+		row.parameters.append(Token(text, i));
+	}
+
+	row.type = ObjectTypes::function;
+	row.schema = Token(text, 0);
+	row.name = Token(text, 1);
+	return true;
+}
+
+// Parses line of dependency list: "schema name type"
+bool ListFileParser::ParseDependencyLine(const QString &text, int begin, int end, ListFileRow &row)
+{
+	if (tokens.count() < 3)
+	{
+		return Fail(end - begin + 1, "schema, name and type expected");
+	}
+
+	if (tokens.count() > 3)
+	{
+		return Fail(tokens.at(3).first - begin + 1, "unexpected text after object type");
+	}
+
+	const auto type = TokenType(text, 2);
+
+	if (type == ObjectTypes::type_count || type == ObjectTypes::script)
+	{
+		return Fail(tokens.at(2).first - begin + 1, "unknown object type \"" + Token(text, 2) + "\"");
+	}
+
+	row = ListFileRow{ type, Token(text, 0), Token(text, 1), QStringList() };
+	return true;
+}
+
+// Compares token with value without copying it
+bool ListFileParser::IsToken(const QString &text, int token_index, const QString &value) const
+{
+	const auto &token = tokens.at(token_index);
+	return QStringRef(&text, token.first, token.second) == value;
+}
+
+// Returns type index by type name token or type_count if it is not a type name
+int ListFileParser::TokenType(const QString &text, int token_index) const
+{
+	for (auto i = 0; i < ObjectTypes::type_count; ++i)
+	{
+		if (IsToken(text, token_index, ObjectTypes::type_names.value(i)))
+		{
+			return i;
+		}
+	}
+
+	return ObjectTypes::type_count;
+}
+
+// Returns copy of token
+QString ListFileParser::Token(const QString &text, int token_index) const
+{
+	const auto &token = tokens.at(token_index);
+	return text.mid(token.first, token.second);
+}
+
+// Saves error description with current line and given column
+bool ListFileParser::Fail(int column, const QString &message)
+{
+	error_message = QString("line %1, column %2: %3").arg(line_number).arg(column).arg(message);
+	return false;
+}
\ No newline at end of file
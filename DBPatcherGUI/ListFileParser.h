@@ -0,0 +1,64 @@
+#pragma once
+
+#include "PatchList.h"
+
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// Object parsed from one line of list file
+struct ListFileRow
+{
+	// Object type index
+	int type;
+	// Object schema
+	QString schema;
+	// Object name
+	QString name;
+	// Function parameter types
+	QStringList parameters;
+};
+
+// Class implementing single-pass parser of object list and dependency list files
+// File is read in large blocks and every line is split into tokens in place, without regular expressions
+// and temporary string lists. Parse error is reported with its line and column
+class ListFileParser
+{
+public:
+
+	enum Formats
+	{
+		object_list_format,
+		dependency_list_format
+	};
+
+	ListFileParser(Formats format);
+	PatchList Parse(const QString &path, bool &is_successful);
+	bool ParseRow(const QString &line, int line_number, ListFileRow &row);
+	QString GetErrorMessage() const;
+private:
+	// Format of parsed file
+	Formats format;
+	// Parsed objects
+	PatchList objects;
+	// Number of current line, starting from 1
+	int line_number;
+	// Description of the first error with its position
+	QString error_message;
+	// Positions and lengths of tokens of current line, reused for all lines
+	QVector<QPair<int, int>> tokens;
+	// Row of current line, reused for all lines
+	ListFileRow current_row;
+	// Size of file block read at once
+	static const int block_size;
+	bool ParseLine(const QString &text, int begin, int end);
+	bool Tokenize(const QString &text, int begin, int &end);
+	bool ParseTokens(const QString &text, int begin, int end, ListFileRow &row);
+	bool ParseObjectLine(const QString &text, int begin, int end, ListFileRow &row);
+	bool ParseDependencyLine(const QString &text, int begin, int end, ListFileRow &row);
+	bool IsToken(const QString &text, int token_index, const QString &value) const;
+	int TokenType(const QString &text, int token_index) const;
+	QString Token(const QString &text, int token_index) const;
+	bool Fail(int column, const QString &message);
+};
\ No newline at end of file
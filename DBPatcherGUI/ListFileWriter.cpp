@@ -0,0 +1,84 @@
+#include "ListFileWriter.h"
+
+#include <QTextCodec>
+#include <QTextEncoder>
+
+const int ListFileWriter::block_size = 1 << 19;
+
+// Constructor
+ListFileWriter::ListFileWriter(const QString &path)
+	: file(path)
+	, encoder(QTextCodec::codecForLocale()->makeEncoder())
+{
+}
+
+// Destructor, drops temporary file if the writer is not committed
+ListFileWriter::~ListFileWriter()
+{
+	if (file.isOpen())
+	{
+		file.cancelWriting();
+	}
+}
+
+// Opens temporary file for writing
+// Text mode is kept, so line ends are the same as in files written by QTextStream before
+bool ListFileWriter::Open()
+{
+	buffer.reserve(block_size + 1024);
+	return file.open(QIODevice::WriteOnly | QIODevice::Text);
+}
+
+// Adds text to buffer, writing the buffer when it is full
+void ListFileWriter::Write(const QString &text)
+{
+	buffer.append(text);
+
+	if (buffer.size() >= block_size)
+	{
+		Flush();
+	}
+}
+
+// Adds character to buffer
+void ListFileWriter::Write(QChar character)
+{
+	buffer.append(character);
+}
+
+// Ends current line
+void ListFileWriter::EndLine()
+{
+	buffer.append('\n');
+
+	if (buffer.size() >= block_size)
+	{
+		Flush();
+	}
+}
+
+// Writes the rest of buffer, syncs temporary file to disk and replaces the target file with it
+// Errors of previous writes are reported here, as QSaveFile does not commit a file with failed writes
+bool ListFileWriter::Commit()
+{
+	Flush();
+	return file.commit();
+}
+
+// Returns description of the last file error
+QString ListFileWriter::GetErrorMessage() const
+{
+	return file.errorString();
+}
+
+// Encodes and writes buffer to temporary file
+void ListFileWriter::Flush()
+{
+	if (buffer.isEmpty())
+	{
+		return;
+	}
+
+	file.write(encoder->fromUnicode(buffer));
+	buffer.clear();
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <QSaveFile>
+#include <QString>
+#include <memory>
+
+class QTextEncoder;
+
+// Class implementing buffered atomic writer of list files
+// Text is collected in a large buffer and encoded and written by blocks into a temporary file,
+// which replaces the target file only on commit after its data is synced to disk, so the target is never left partial or missing
+class ListFileWriter
+{
+public:
+	ListFileWriter(const QString &path);
+	~ListFileWriter();
+	bool Open();
+	void Write(const QString &text);
+	void Write(QChar character);
+	void EndLine();
+	bool Commit();
+	QString GetErrorMessage() const;
+private:
+	// Temporary file replacing the target on commit
+	QSaveFile file;
+	// Encoder of text into local encoding, as QTextStream does it
+	std::unique_ptr<QTextEncoder> encoder;
+	// Text not written yet
+	QString buffer;
+	// Amount of characters collected before writing
+	static const int block_size;
+	void Flush();
+};
\ No newline at end of file
@@ -0,0 +1,232 @@
+#include "LogFileModel.h"
+#include "FunctionTask.h"
+
+#include <QFile>
+#include <QFileInfo>
+
+const int LogFileModel::page_size = 1024;
+const int LogFileModel::block_size = 4 * 1024 * 1024;
+const int LogFileModel::page_cache_size = 64;
+
+// Constructor
+LogFileModel::LogFileModel(QObject *parent)
+	: QAbstractListModel(parent)
+	, line_index{ { 0 }, 0, 0, 0 }
+	, page_cache(page_cache_size)
+	, index_id(0)
+	, is_indexing(false)
+{
+	pool.setMaxThreadCount(1);
+}
+
+// Destructor, stops indexing and waits for it, so it never reports to a deleted object
+LogFileModel::~LogFileModel()
+{
+	index_id.ref();
+	pool.waitForDone();
+}
+
+// Shows log file from the start, its lines are indexed in background and shown when they are indexed
+// Running indexing is stopped
+void LogFileModel::Open(const QString &path)
+{
+	beginResetModel();
+	this->path = path;
+	line_index = LogFileIndex{ { 0 }, 0, 0, 0 };
+	page_cache.clear();
+	endResetModel();
+	StartIndexing();
+}
+
+// Indexes lines appended to the file since the last indexing, nothing is done while indexing is running
+// If the file is smaller than it was, it is rotated and opened from the start
+void LogFileModel::Refresh()
+{
+	if (is_indexing)
+	{
+		return;
+	}
+
+	if (QFileInfo(path).size() < line_index.indexed_size)
+	{
+		Open(path);
+		return;
+	}
+
+	StartIndexing();
+}
+
+// Checks if lines are being indexed
+bool LogFileModel::IsIndexing() const
+{
+	return is_indexing;
+}
+
+// Starts indexing of lines after the indexed part in the worker thread
+// Result is applied in the owner thread unless another indexing is started meanwhile
+void LogFileModel::StartIndexing()
+{
+	const auto id = index_id.fetchAndAddOrdered(1) + 1;
+	const auto indexed_path = path;
+	const auto base_index = line_index;
+	is_indexing = true;
+
+	pool.start(new FunctionTask([=]()
+	{
+		auto new_index = base_index;
+		QString error_message = "";
+		const auto is_successful = IndexLines(id, indexed_path, new_index, error_message);
+
+		QMetaObject::invokeMethod(this, [=]()
+		{
+			if (id != index_id.loadAcquire())
+			{
+				return;
+			}
+
+			is_indexing = false;
+
+			if (is_successful)
+			{
+				ApplyIndex(new_index);
+			}
+
+			emit Indexed(is_successful, error_message);
+		}, Qt::QueuedConnection);
+	}));
+}
+
+// Replaces index by the one extended with new lines
+// New lines are committed between beginInsertRows and endInsertRows, so views never see rows before they are announced
+void LogFileModel::ApplyIndex(const LogFileIndex &new_index)
+{
+	const auto old_row_count = rowCount();
+	const auto new_row_count = RowCount(new_index);
+
+	if (new_row_count > old_row_count)
+	{
+		beginInsertRows(QModelIndex(), old_row_count, new_row_count - 1);
+	}
+
+	line_index = new_index;
+
+	// Last page and last line could be incomplete when they were read
+	page_cache.remove((old_row_count - 1) / page_size);
+	page_cache.remove(old_row_count / page_size);
+
+	if (new_row_count > old_row_count)
+	{
+		endInsertRows();
+	}
+
+	if (old_row_count > 0)
+	{
+		emit dataChanged(index(old_row_count - 1), index(old_row_count - 1));
+	}
+}
+
+// Returns path of opened file
+QString LogFileModel::GetPath() const
+{
+	return path;
+}
+
+// Returns amount of lines, the last incomplete line is counted too
+int LogFileModel::rowCount(const QModelIndex &parent) const
+{
+	if (parent.isValid())
+	{
+		return 0;
+	}
+
+	return RowCount(line_index);
+}
+
+// Returns line of the row, reading its page if it is not cached
+QVariant LogFileModel::data(const QModelIndex &index, int role) const
+{
+	if (!index.isValid() || role != Qt::DisplayRole)
+	{
+		return QVariant();
+	}
+
+	const auto lines = Page(index.row() / page_size);
+	return lines ? lines->value(index.row() % page_size) : QVariant();
+}
+
+// Reads file from the end of indexed part and adds offsets of pages to the index
+// Runs in the worker thread, reading stops when another indexing is started
+bool LogFileModel::IndexLines(int id, const QString &indexed_path, LogFileIndex &file_index, QString &error_message) const
+{
+	QFile file(indexed_path);
+
+	if (!file.open(QIODevice::ReadOnly) || !file.seek(file_index.indexed_size))
+	{
+		error_message = file.errorString();
+		return false;
+	}
+
+	auto offset = file_index.indexed_size;
+
+	while (!file.atEnd())
+	{
+		if (id != index_id.loadAcquire())
+		{
+			return false;
+		}
+
+		const auto block = file.read(block_size);
+
+		if (block.isEmpty())
+		{
+			break;
+		}
+
+		auto line_end = -1;
+
+		while ((line_end = block.indexOf('\n', line_end + 1)) != -1)
+		{
+			++file_index.line_count;
+			file_index.indexed_size = offset + line_end + 1;
+
+			if (file_index.line_count % page_size == 0)
+			{
+				file_index.page_offsets.append(file_index.indexed_size);
+			}
+		}
+
+		offset += block.size();
+	}
+
+	file_index.file_size = offset;
+	return true;
+}
+
+// Returns amount of rows of index, the last incomplete line is counted too
+int LogFileModel::RowCount(const LogFileIndex &file_index)
+{
+	return file_index.file_size > file_index.indexed_size ? file_index.line_count + 1 : file_index.line_count;
+}
+
+// Returns lines of page, reading them from file if the page is not cached
+// Returns null if the page is not read
+const QStringList* LogFileModel::Page(int page) const
+{
+	if (const auto lines = page_cache.object(page))
+	{
+		return lines;
+	}
+
+	QFile file(path);
+	const auto page_offset = line_index.page_offsets.value(page, line_index.file_size);
+	const auto page_end = page + 1 < line_index.page_offsets.count() ? line_index.page_offsets[page + 1] : line_index.file_size;
+
+	if (!file.open(QIODevice::ReadOnly) || !file.seek(page_offset))
+	{
+		return nullptr;
+	}
+
+	const auto lines = new QStringList(QString::fromUtf8(file.read(page_end - page_offset)).split('\n'));
+	page_cache.insert(page, lines);
+	return lines;
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QAtomicInt>
+#include <QCache>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVector>
+
+// Index of lines of log file
+struct LogFileIndex
+{
+	// Offsets of the first lines of pages
+	QVector<qint64> page_offsets;
+	// Amount of complete lines
+	int line_count;
+	// Size of indexed part of file, which ends with line break
+	qint64 indexed_size;
+	// Size of file, it is larger than indexed size if the last line is not complete
+	qint64 file_size;
+};
+
+// Class implementing model of log file lines
+// Only offsets of every page of lines are kept in memory, pages are read from disk as they are shown,
+// so files of any size are browsed with constant memory.
+// Lines are indexed in a worker thread, indexed rows are added when it is finished and Indexed is emitted
+class LogFileModel : public QAbstractListModel
+{
+	Q_OBJECT
+
+public:
+	LogFileModel(QObject *parent = nullptr);
+	~LogFileModel();
+	void Open(const QString &path);
+	void Refresh();
+	bool IsIndexing() const;
+	QString GetPath() const;
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+signals:
+	void Indexed(bool is_successful, const QString &error_message);
+private:
+	// Path of log file
+	QString path;
+	// Index of shown lines
+	LogFileIndex line_index;
+	// Recently shown pages
+	mutable QCache<int, QStringList> page_cache;
+	// Pool running indexing in its only thread
+	QThreadPool pool;
+	// Id of the current indexing, previous ones are stopped and their results are dropped
+	QAtomicInt index_id;
+	// Flag showing if indexing is running, used only in the owner thread
+	bool is_indexing;
+	// Amount of lines in page
+	static const int page_size;
+	// Size of block in which file is read while it is indexed
+	static const int block_size;
+	// Amount of pages kept in cache
+	static const int page_cache_size;
+	void StartIndexing();
+	void ApplyIndex(const LogFileIndex &new_index);
+	bool IndexLines(int id, const QString &indexed_path, LogFileIndex &file_index, QString &error_message) const;
+	static int RowCount(const LogFileIndex &file_index);
+	const QStringList* Page(int page) const;
+};
\ No newline at end of file
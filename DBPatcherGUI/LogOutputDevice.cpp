@@ -1,37 +1,109 @@
 #include "LogOutputDevice.h"
+#include "LogStorage.h"
 
-#include <QTextEdit>
+#include <QPlainTextEdit>
 #include <QScrollBar>
 #include <QTextCodec>
+#include <QTextCursor>
+#include <QTimer>
+
+const int LogOutputDevice::flush_interval = 50;
+const int LogOutputDevice::buffer_capacity = 1024 * 1024;
 
 // Constructor
 LogOutputDevice::LogOutputDevice(QObject *parent)
 	: QIODevice(parent)
 	, text_edit(nullptr)
+	, codec(QTextCodec::codecForName("Windows-1251"))
+	, flush_timer(new QTimer(this))
+	, is_line_break_pending(false)
 {
+	flush_timer->setSingleShot(true);
+	flush_timer->setInterval(flush_interval);
+	connect(flush_timer, &QTimer::timeout, this, &LogOutputDevice::Flush);
 }
 
-// Sets new QTextEdit for output
-void LogOutputDevice::SetTextEdit(QTextEdit *text_edit)
+// Sets new QPlainTextEdit for output
+void LogOutputDevice::SetTextEdit(QPlainTextEdit *text_edit)
 {
 	this->text_edit = text_edit;
 }
 
-// Re-implements QTextEdit reading virtual method
-qint64 LogOutputDevice::readData(char *data, qint64 maxlen)
+// Writes message of application as a separate line
+void LogOutputDevice::WriteMessage(const QString &message)
 {
-	return 0;
+	Push(message + '\n');
 }
 
-// Re-implements QTextEdit writing virtual method
-qint64 LogOutputDevice::writeData(const char *data, qint64 len)
+// Stores all collected text on disk and shows it at the end of the view
+void LogOutputDevice::Flush()
 {
-	if (text_edit)
+	flush_timer->stop();
+
+	if (buffer.isEmpty())
+	{
+		return;
+	}
+
+	QString text;
+	text.swap(buffer);
+
+	LogStorage::Append(text);
+
+	if (!text_edit)
 	{
-		// It should be possibly fixed on Linux
-		text_edit->append(QTextCodec::codecForName("Windows-1251")->toUnicode(data));
-		text_edit->verticalScrollBar()->setValue(text_edit->verticalScrollBar()->maximum());
+		return;
 	}
 
+	if (is_line_break_pending)
+	{
+		text.prepend('\n');
+	}
+
+	is_line_break_pending = text.endsWith('\n');
+
+	if (is_line_break_pending)
+	{
+		text.chop(1);
+	}
+
+	QTextCursor cursor(text_edit->document());
+	cursor.movePosition(QTextCursor::End);
+	cursor.insertText(text);
+	text_edit->verticalScrollBar()->setValue(text_edit->verticalScrollBar()->maximum());
+}
+
+// Adds text to buffer and schedules its showing
+// If buffer is full, collected text is shown at once, so the buffer does not grow while output is continuous
+void LogOutputDevice::Push(const QString &text)
+{
+	buffer.append(text);
+
+	if (buffer.size() >= buffer_capacity)
+	{
+		Flush();
+		return;
+	}
+
+	if (!flush_timer->isActive())
+	{
+		flush_timer->start();
+	}
+}
+
+// Re-implements QIODevice reading virtual method
+qint64 LogOutputDevice::readData(char *data, qint64 maxlen)
+{
+	return 0;
+}
+
+// Re-implements QIODevice writing virtual method
+// Module output is decoded at once, and carriage returns of Windows line breaks are dropped
+qint64 LogOutputDevice::writeData(const char *data, qint64 len)
+{
+	// It should be possibly fixed on Linux
+	auto text = codec ? codec->toUnicode(data, static_cast<int>(len)) : QString::fromLocal8Bit(data, static_cast<int>(len));
+	text.remove('\r');
+	Push(text);
 	return len;
 }
\ No newline at end of file
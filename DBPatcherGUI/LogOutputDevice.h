@@ -1,20 +1,41 @@
 #pragma once
 
 #include <QIODevice>
+#include <QString>
 
-class QTextEdit;
+class QPlainTextEdit;
+class QTextCodec;
+class QTimer;
 
-// Output device class which redirects its output to QTextEdit
+// Output device class which redirects its output to QPlainTextEdit
+// Written text is collected and shown by batches, so frequent small writes do not redraw the view each time
+// Module output and application messages are all written on the GUI thread, so the buffer needs no synchronization
 class LogOutputDevice : public QIODevice
 {
 	Q_OBJECT
 
 public:
 	LogOutputDevice(QObject *parent = nullptr);
-	void SetTextEdit(QTextEdit *text_edit);
+	void SetTextEdit(QPlainTextEdit *text_edit);
+	void WriteMessage(const QString &message);
+	void Flush();
 private:
-	// QTextEdit object to which output is redirected
-	QTextEdit *text_edit;
+	// QPlainTextEdit object to which output is redirected
+	QPlainTextEdit *text_edit;
+	// Codec of module output, it is found once
+	QTextCodec *codec;
+	// Text waiting to be shown
+	QString buffer;
+	// Timer showing collected text
+	QTimer *flush_timer;
+	// Flag showing if shown text ends with line break, which is added with the next text
+	// So the last line of the view is not empty
+	bool is_line_break_pending;
+	// Interval of view updates in milliseconds
+	static const int flush_interval;
+	// Amount of collected characters which are shown at once, without waiting for the timer
+	static const int buffer_capacity;
+	void Push(const QString &text);
 protected:
 	qint64 readData(char* data, qint64 maxlen) override;
 	qint64 writeData(const char* data, qint64 len) override;
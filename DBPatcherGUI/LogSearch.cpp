@@ -0,0 +1,217 @@
+#include "LogSearch.h"
+#include "FunctionTask.h"
+
+#include <QByteArrayMatcher>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <algorithm>
+
+const int LogSearch::max_match_count = 10000;
+const int LogSearch::block_size = 4 * 1024 * 1024;
+
+// Constructor
+LogSearch::LogSearch(QObject *parent)
+	: QObject(parent)
+	, is_cancelled(0)
+	, search_id(0)
+	, is_running(false)
+{
+	pool.setMaxThreadCount(1);
+}
+
+// Destructor, stops the search and waits for it, so it never reports to a deleted object
+LogSearch::~LogSearch()
+{
+	Cancel();
+	pool.waitForDone();
+}
+
+// Starts search of pattern in files, a running search is cancelled
+// Returns false if regular expression is incorrect
+bool LogSearch::Start(const QStringList &paths, const QString &pattern, bool is_regular_expression, QString &error_message)
+{
+	const QRegularExpression expression(pattern);
+
+	if (is_regular_expression && !expression.isValid())
+	{
+		error_message = "Incorrect regular expression: " + expression.errorString();
+		return false;
+	}
+
+	Cancel();
+	pool.waitForDone();
+	is_cancelled.storeRelease(0);
+	is_running = true;
+	const auto id = ++search_id;
+
+	pool.start(new FunctionTask([=]()
+	{
+		Run(id, paths, pattern, is_regular_expression);
+	}));
+
+	return true;
+}
+
+// Stops the running search, Finished is not emitted for it
+void LogSearch::Cancel()
+{
+	is_cancelled.storeRelease(1);
+	is_running = false;
+	++search_id;
+}
+
+// Checks if search is running
+bool LogSearch::IsRunning() const
+{
+	return is_running;
+}
+
+// Searches files in the worker thread and posts matches, progress and result to the owner thread
+// Matches refer to files by their indexes in the searched list, as paths of log files are changed by rotation
+// Lines are counted from 0 in every file, search stops after max_match_count matches
+void LogSearch::Run(int id, const QStringList &paths, const QString &pattern, bool is_regular_expression)
+{
+	const QRegularExpression expression(pattern);
+	const QByteArrayMatcher matcher(pattern.toUtf8());
+	qint64 total_size = 0;
+	qint64 searched_size = 0;
+	auto match_count = 0;
+	auto last_percent = -1;
+
+	for (const auto &path : paths)
+	{
+		total_size += QFileInfo(path).size();
+	}
+
+	for (auto file_index = 0; file_index < paths.count(); ++file_index)
+	{
+		const auto &path = paths.at(file_index);
+		QFile file(path);
+
+		if (!file.open(QIODevice::ReadOnly))
+		{
+			PostFinished(id, false, path + ": " + file.errorString());
+			return;
+		}
+
+		auto line = 0;
+		QByteArray rest;
+
+		while (true)
+		{
+			if (is_cancelled.loadAcquire())
+			{
+				return;
+			}
+
+			auto chunk = rest + file.read(block_size);
+			const auto is_end = file.atEnd();
+
+			// Chunk is cut after its last line break, so lines are never split between chunks
+			const auto chunk_size = is_end ? chunk.size() : chunk.lastIndexOf('\n') + 1;
+			rest = chunk.mid(chunk_size);
+			chunk.truncate(chunk_size);
+			searched_size += chunk_size;
+
+			QVector<int> rows;
+			QStringList lines;
+
+			if (is_regular_expression)
+			{
+				const auto chunk_lines = QString::fromUtf8(chunk).split('\n');
+				const auto complete_line_count = chunk.endsWith('\n') ? chunk_lines.count() - 1 : chunk_lines.count();
+
+				for (auto i = 0; i < complete_line_count && match_count + rows.count() < max_match_count; ++i)
+				{
+					if (expression.match(chunk_lines.at(i)).hasMatch())
+					{
+						rows.append(line + i);
+						lines.append(chunk_lines.at(i));
+					}
+				}
+
+				line += complete_line_count;
+			}
+			else
+			{
+				auto counted_position = 0;
+				auto search_position = 0;
+				auto match_position = 0;
+
+				// Every line is reported once, search goes on from the end of the found line
+				while (match_count + rows.count() < max_match_count && (match_position = matcher.indexIn(chunk, search_position)) != -1)
+				{
+					line += std::count(chunk.constData() + counted_position, chunk.constData() + match_position, '\n');
+					counted_position = match_position;
+					const auto line_begin = chunk.lastIndexOf('\n', match_position) + 1;
+					const auto found_line_end = chunk.indexOf('\n', match_position);
+					const auto line_end = found_line_end == -1 ? chunk.size() : found_line_end;
+					search_position = line_end + 1;
+					rows.append(line);
+					lines.append(QString::fromUtf8(chunk.constData() + line_begin, line_end - line_begin));
+				}
+
+				line += std::count(chunk.constData() + counted_position, chunk.constData() + chunk.size(), '\n');
+			}
+
+			match_count += rows.count();
+
+			if (!rows.isEmpty())
+			{
+				Post(id, [this, file_index, rows, lines]()
+				{
+					emit MatchesFound(file_index, rows, lines);
+				});
+			}
+
+			const auto percent = total_size == 0 ? 100 : static_cast<int>(qMin<qint64>(searched_size * 100 / total_size, 100));
+
+			if (percent != last_percent)
+			{
+				last_percent = percent;
+				Post(id, [this, percent]()
+				{
+					emit Progress(percent);
+				});
+			}
+
+			if (match_count >= max_match_count)
+			{
+				PostFinished(id, true, QString("Search is stopped after %1 matches").arg(max_match_count));
+				return;
+			}
+
+			if (is_end)
+			{
+				break;
+			}
+		}
+	}
+
+	PostFinished(id, true, "");
+}
+
+// Runs function in the owner thread if the search is still the current one
+void LogSearch::Post(int id, const std::function<void()> &function)
+{
+	QMetaObject::invokeMethod(this, [this, id, function]()
+	{
+		if (id != search_id)
+		{
+			return;
+		}
+
+		function();
+	}, Qt::QueuedConnection);
+}
+
+// Reports the end of search in the owner thread, it is the last report of the search
+void LogSearch::PostFinished(int id, bool is_successful, const QString &error_message)
+{
+	Post(id, [this, is_successful, error_message]()
+	{
+		is_running = false;
+		emit Finished(is_successful, error_message);
+	});
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVector>
+#include <functional>
+
+// Class searching log files in a worker thread
+// Files are read by large blocks, substring is searched in undecoded contents, regular expression is matched with decoded lines.
+// Matches are reported by batches of a block as they are found, so the dialog stays responsive while the whole history is searched
+class LogSearch : public QObject
+{
+	Q_OBJECT
+
+public:
+	LogSearch(QObject *parent = nullptr);
+	~LogSearch();
+	bool Start(const QStringList &paths, const QString &pattern, bool is_regular_expression, QString &error_message);
+	void Cancel();
+	bool IsRunning() const;
+signals:
+	void MatchesFound(int file_index, const QVector<int> &rows, const QStringList &lines);
+	void Progress(int percent);
+	void Finished(bool is_successful, const QString &error_message);
+private:
+	// Pool running the search in its only thread
+	QThreadPool pool;
+	// Flag stopping the running search, checked before every block
+	QAtomicInt is_cancelled;
+	// Id of the current search, reports of previous ones are dropped
+	int search_id;
+	// Flag showing if search is running, used only in the owner thread
+	bool is_running;
+	// Amount of matches after which search is stopped
+	static const int max_match_count;
+	// Size of block in which files are read
+	static const int block_size;
+	void Run(int id, const QStringList &paths, const QString &pattern, bool is_regular_expression);
+	void Post(int id, const std::function<void()> &function);
+	void PostFinished(int id, bool is_successful, const QString &error_message);
+};
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "LogStorage.h"
+
+#include <QDir>
+
+QString LogStorage::directory;
+QFile LogStorage::file;
+int LogStorage::rotation_count = 0;
+qint64 LogStorage::rotation_size = 128 * 1024 * 1024;
+const qint64 LogStorage::max_file_size = 128 * 1024 * 1024;
+const qint64 LogStorage::rotation_retry_size = 16 * 1024 * 1024;
+const int LogStorage::max_file_count = 8;
+
+// Sets directory of log files, the current file is reopened in it with the next text
+void LogStorage::SetDirectory(const QString &path)
+{
+	file.close();
+	directory = path;
+	rotation_size = max_file_size;
+}
+
+// Appends text to the current log file as UTF-8
+// File is flushed at once, so log viewer reads it up to date
+// If rotation fails, for example because a file is opened by another program, text is appended to the current file
+void LogStorage::Append(const QString &text)
+{
+	if (directory.isEmpty() || (!file.isOpen() && !Open()))
+	{
+		return;
+	}
+
+	file.write(text.toUtf8());
+	file.flush();
+
+	if (file.size() >= rotation_size)
+	{
+		rotation_size = Rotate() ? max_file_size : file.size() + rotation_retry_size;
+	}
+}
+
+// Closes the current log file, it is reopened with the next text
+void LogStorage::Close()
+{
+	file.close();
+}
+
+// Returns ids of existing log files from the current one to the oldest one
+QList<int> LogStorage::FileIds()
+{
+	QList<int> file_ids;
+
+	for (auto i = 0; i < max_file_count; ++i)
+	{
+		if (QFile::exists(NumberedFilePath(i)))
+		{
+			file_ids.append(rotation_count - i);
+		}
+	}
+
+	return file_ids;
+}
+
+// Returns path of log file by its id, empty if the file is removed by rotation
+QString LogStorage::FilePath(int file_id)
+{
+	const auto number = rotation_count - file_id;
+	return number >= 0 && number < max_file_count ? NumberedFilePath(number) : QString();
+}
+
+// Returns path of log file by its number, 0 is the current file
+QString LogStorage::NumberedFilePath(int number)
+{
+	return number == 0 ? directory + "/Patcher.log" : QString("%1/Patcher.%2.log").arg(directory).arg(number);
+}
+
+// Opens the current log file for appending
+bool LogStorage::Open()
+{
+	QDir().mkpath(directory);
+	file.setFileName(NumberedFilePath(0));
+	return file.open(QIODevice::WriteOnly | QIODevice::Append);
+}
+
+// Renames the current file and older ones to the next numbers, the oldest file is removed
+// Current file is moved aside first, as it is the one most likely opened by another program, so its failure changes nothing.
+// Renaming stops at the first failure, then the current file is moved back, ids are shifted only if all files are renamed
+// Current file is reopened with the next text
+bool LogStorage::Rotate()
+{
+	file.close();
+
+	const auto rotated_path = directory + "/Patcher.rotated.log";
+	const auto oldest_path = NumberedFilePath(max_file_count - 1);
+	QFile::remove(rotated_path);
+
+	if (!QFile::rename(NumberedFilePath(0), rotated_path))
+	{
+		return false;
+	}
+
+	auto is_successful = !QFile::exists(oldest_path) || QFile::remove(oldest_path);
+
+	for (auto i = max_file_count - 2; i >= 1 && is_successful; --i)
+	{
+		is_successful = !QFile::exists(NumberedFilePath(i)) || QFile::rename(NumberedFilePath(i), NumberedFilePath(i + 1));
+	}
+
+	if (!is_successful || !QFile::rename(rotated_path, NumberedFilePath(1)))
+	{
+		QFile::rename(rotated_path, NumberedFilePath(0));
+		return false;
+	}
+
+	++rotation_count;
+	return true;
+}
\ No newline at end of file
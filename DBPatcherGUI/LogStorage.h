@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QFile>
+#include <QList>
+#include <QString>
+
+// Class keeping log history on disk
+// Log is appended to the current file, which is rotated when it grows too large, so only a few latest files are kept
+// Files are renamed by rotation, so they are referred to by ids, which stay the same while the file is kept
+class LogStorage
+{
+public:
+	LogStorage() = delete;
+	static void SetDirectory(const QString &path);
+	static void Append(const QString &text);
+	static void Close();
+	static QList<int> FileIds();
+	static QString FilePath(int file_id);
+private:
+	// Directory of log files
+	static QString directory;
+	// Current log file
+	static QFile file;
+	// Amount of completed rotations, file id is its number subtracted from it
+	static int rotation_count;
+	// Size of file starting from which it is rotated, it is increased after failed rotation, so it is not retried on every text
+	static qint64 rotation_size;
+	// Size of file starting from which it is rotated
+	static const qint64 max_file_size;
+	// Growth of file after which failed rotation is retried
+	static const qint64 rotation_retry_size;
+	// Amount of kept files including the current one
+	static const int max_file_count;
+	static QString NumberedFilePath(int number);
+	static bool Open();
+	static bool Rotate();
+};
\ No newline at end of file
@@ -0,0 +1,290 @@
+#include "LogViewerWindow.h"
+#include "ui_LogViewerWindow.h"
+#include "LogFileModel.h"
+#include "LogSearch.h"
+#include "LogStorage.h"
+
+#include <QFileInfo>
+#include <QListWidgetItem>
+
+// Constructor
+LogViewerWindow::LogViewerWindow(QWidget *parent)
+	: QDialog(parent)
+	, ui(new Ui::LogViewerWindow)
+	, model(new LogFileModel(this))
+	, search(new LogSearch(this))
+	, pending_row(-1)
+	, is_scroll_pending(false)
+{
+	ui->setupUi(this);
+	setWindowFlag(Qt::WindowContextHelpButtonHint, false);
+	ui->log_view->setModel(model);
+
+	connect(ui->file_combo_box, SIGNAL(currentIndexChanged(int)), this, SLOT(OnCurrentFileChanged(int)));
+	connect(ui->refresh_button, &QToolButton::clicked, this, &LogViewerWindow::OnRefreshButtonClicked);
+	connect(model, &LogFileModel::Indexed, this, &LogViewerWindow::OnFileIndexed);
+	connect(ui->find_button, &QPushButton::clicked, this, &LogViewerWindow::OnFindButtonClicked);
+	connect(ui->search_edit, &QLineEdit::returnPressed, this, &LogViewerWindow::OnFindButtonClicked);
+	connect(ui->match_list_widget, &QListWidget::currentItemChanged, this, &LogViewerWindow::OnMatchActivated);
+	connect(search, &LogSearch::MatchesFound, this, &LogViewerWindow::OnMatchesFound);
+	connect(search, &LogSearch::Progress, this, &LogViewerWindow::OnSearchProgress);
+	connect(search, &LogSearch::Finished, this, &LogViewerWindow::OnSearchFinished);
+}
+
+// Destructor
+LogViewerWindow::~LogViewerWindow()
+{
+	delete ui;
+}
+
+// Fills list of log files and opens the dialog with the current file shown from its end
+// Files are listed by their ids, so a file is found after it is renamed by rotation
+void LogViewerWindow::OpenLogViewer()
+{
+	ui->file_combo_box->blockSignals(true);
+	ui->file_combo_box->clear();
+
+	for (const auto file_id : LogStorage::FileIds())
+	{
+		ui->file_combo_box->addItem(QFileInfo(LogStorage::FilePath(file_id)).fileName(), file_id);
+	}
+
+	ui->file_combo_box->blockSignals(false);
+	OnCurrentFileChanged(ui->file_combo_box->currentIndex());
+	show();
+	raise();
+}
+
+// Handles choice of log file
+// File is indexed in background, it is shown from its end when it is indexed
+void LogViewerWindow::OnCurrentFileChanged(int index)
+{
+	pending_row = -1;
+	is_scroll_pending = false;
+
+	if (index == -1)
+	{
+		ui->status_label->setText("Log history is empty");
+		return;
+	}
+
+	const auto path = LogStorage::FilePath(ui->file_combo_box->itemData(index).toInt());
+
+	if (path.isEmpty())
+	{
+		ui->status_label->setText("Log file is removed by rotation");
+		return;
+	}
+
+	is_scroll_pending = true;
+	model->Open(path);
+	ui->status_label->setText("Reading...");
+}
+
+// Handles refresh button click
+// Shows lines added to the file since it was opened, file renamed by rotation is opened by its new path
+void LogViewerWindow::OnRefreshButtonClicked()
+{
+	if (ui->file_combo_box->currentIndex() == -1)
+	{
+		return;
+	}
+
+	const auto path = LogStorage::FilePath(ui->file_combo_box->currentData().toInt());
+
+	if (path.isEmpty())
+	{
+		ui->status_label->setText("Log file is removed by rotation");
+		return;
+	}
+
+	if (path != model->GetPath())
+	{
+		model->Open(path);
+	}
+	else
+	{
+		model->Refresh();
+	}
+
+	ui->status_label->setText("Reading...");
+}
+
+// Handles finish of shown file indexing, selects the line waiting for it
+void LogViewerWindow::OnFileIndexed(bool is_successful, const QString &error_message)
+{
+	const auto row = pending_row;
+	const auto is_scrolled = is_scroll_pending;
+	pending_row = -1;
+	is_scroll_pending = false;
+
+	if (!is_successful)
+	{
+		ui->status_label->setText("Log file is not read: " + error_message);
+		return;
+	}
+
+	ui->status_label->setText(QString("%1 lines").arg(model->rowCount()));
+
+	if (row != -1)
+	{
+		SelectRow(row);
+	}
+	else if (is_scrolled)
+	{
+		ui->log_view->scrollToBottom();
+	}
+}
+
+// Handles find button click
+// Searches all log files in the background, matches are listed as they are found
+// While search is running, the button cancels it
+void LogViewerWindow::OnFindButtonClicked()
+{
+	QString error_message = "";
+	const auto pattern = ui->search_edit->text();
+
+	if (search->IsRunning())
+	{
+		search->Cancel();
+		SetSearchRunning(false);
+		ui->status_label->setText(QString("Search is cancelled, %1 matches").arg(ui->match_list_widget->count()));
+		return;
+	}
+
+	if (pattern.isEmpty())
+	{
+		return;
+	}
+
+	ui->match_list_widget->clear();
+	search_file_ids = LogStorage::FileIds();
+	QStringList paths;
+
+	for (const auto file_id : search_file_ids)
+	{
+		paths.append(LogStorage::FilePath(file_id));
+	}
+
+	if (!search->Start(paths, pattern, ui->regular_expression_check_box->isChecked(), error_message))
+	{
+		ui->status_label->setText(error_message);
+		return;
+	}
+
+	search_timer.start();
+	SetSearchRunning(true);
+	ui->status_label->setText("Searching...");
+}
+
+// Adds found lines to the list of matches, the first match is shown at once
+// Matches keep id of their file, so they are shown in it after the file is renamed by rotation
+void LogViewerWindow::OnMatchesFound(int file_index, const QVector<int> &rows, const QStringList &lines)
+{
+	const auto is_first = ui->match_list_widget->count() == 0;
+	const auto file_id = search_file_ids.at(file_index);
+	const auto file_name = QFileInfo(LogStorage::FilePath(file_id)).fileName();
+
+	for (auto i = 0; i < rows.count(); ++i)
+	{
+		auto item = new QListWidgetItem(QString("%1:%2: %3").arg(file_name).arg(rows.at(i) + 1).arg(lines.at(i)), ui->match_list_widget);
+		item->setData(Qt::UserRole, file_id);
+		item->setData(Qt::UserRole + 1, rows.at(i));
+	}
+
+	if (is_first)
+	{
+		ShowLine(file_id, rows.first());
+	}
+}
+
+// Shows search progress
+void LogViewerWindow::OnSearchProgress(int percent)
+{
+	ui->status_label->setText(QString("Searching... %1%, %2 matches").arg(percent).arg(ui->match_list_widget->count()));
+}
+
+// Handles search finish
+void LogViewerWindow::OnSearchFinished(bool is_successful, const QString &error_message)
+{
+	SetSearchRunning(false);
+
+	if (!is_successful)
+	{
+		ui->status_label->setText("Log files are not searched: " + error_message);
+		return;
+	}
+
+	const auto count = ui->match_list_widget->count();
+	const auto result = count == 0 ? QString("Nothing is found") : QString("%1 matches").arg(count);
+	ui->status_label->setText(QString("%1 in %2 ms%3").arg(result).arg(search_timer.elapsed())
+		.arg(error_message.isEmpty() ? "" : ". " + error_message));
+}
+
+// Handles choice of found line, shows it in its file
+void LogViewerWindow::OnMatchActivated(QListWidgetItem *item)
+{
+	if (!item)
+	{
+		return;
+	}
+
+	ShowLine(item->data(Qt::UserRole).toInt(), item->data(Qt::UserRole + 1).toInt());
+}
+
+// Opens log file if it is not shown and selects its line
+// Line could be written after the file was opened, so the file is refreshed then
+// If the file is being indexed, the line is selected when it is finished
+void LogViewerWindow::ShowLine(int file_id, int row)
+{
+	const auto path = LogStorage::FilePath(file_id);
+	const auto file_index = ui->file_combo_box->findData(file_id);
+
+	if (path.isEmpty() || file_index == -1)
+	{
+		ui->status_label->setText("Log file of the line is removed by rotation");
+		return;
+	}
+
+	if (file_index != ui->file_combo_box->currentIndex())
+	{
+		ui->file_combo_box->setCurrentIndex(file_index);
+	}
+	else if (path != model->GetPath())
+	{
+		model->Open(path);
+	}
+	else if (row >= model->rowCount() || model->IsIndexing())
+	{
+		model->Refresh();
+	}
+	else
+	{
+		SelectRow(row);
+		return;
+	}
+
+	pending_row = row;
+	is_scroll_pending = false;
+}
+
+// Selects line of the shown file if it exists
+void LogViewerWindow::SelectRow(int row)
+{
+	if (row >= model->rowCount())
+	{
+		return;
+	}
+
+	const auto found_index = model->index(row);
+	ui->log_view->setCurrentIndex(found_index);
+	ui->log_view->scrollTo(found_index, QAbstractItemView::PositionAtCenter);
+}
+
+// Switches find button between starting and cancelling search
+void LogViewerWindow::SetSearchRunning(bool is_running)
+{
+	ui->find_button->setText(is_running ? "Cancel" : "Find all");
+	ui->search_edit->setDisabled(is_running);
+	ui->regular_expression_check_box->setDisabled(is_running);
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QDialog>
+#include <QElapsedTimer>
+#include <QList>
+#include <QStringList>
+#include <QVector>
+
+class LogFileModel;
+class LogSearch;
+class QListWidgetItem;
+
+// Namespace required by Qt for loading .ui form file
+namespace Ui
+{
+	class LogViewerWindow;
+}
+
+// Class implementing dialog for browsing and searching log history stored on disk
+class LogViewerWindow : public QDialog
+{
+	Q_OBJECT
+
+public:
+	LogViewerWindow(QWidget *parent = nullptr);
+	~LogViewerWindow();
+	void OpenLogViewer();
+private:
+	// Pointer to ui object required by Qt for loading .ui form file
+	// Ui class is created in editor, and its elements are available through this pointer
+	Ui::LogViewerWindow *ui;
+	// Model of shown log file
+	LogFileModel *model;
+	// Search in all log files
+	LogSearch *search;
+	// Time of the running search
+	QElapsedTimer search_timer;
+	// Ids of searched log files by their indexes in search
+	QList<int> search_file_ids;
+	// Row selected when the shown file is indexed, -1 if there is no one
+	int pending_row;
+	// Flag showing if the view is scrolled to the end when the shown file is indexed
+	bool is_scroll_pending;
+	void ShowLine(int file_id, int row);
+	void SelectRow(int row);
+	void SetSearchRunning(bool is_running);
+private slots:
+	void OnCurrentFileChanged(int index);
+	void OnRefreshButtonClicked();
+	void OnFileIndexed(bool is_successful, const QString &error_message);
+	void OnFindButtonClicked();
+	void OnMatchesFound(int file_index, const QVector<int> &rows, const QStringList &lines);
+	void OnSearchProgress(int percent);
+	void OnSearchFinished(bool is_successful, const QString &error_message);
+	void OnMatchActivated(QListWidgetItem *item);
+};
\ No newline at end of file
@@ -5,13 +5,17 @@
 #include "LoginWindow.h"
 #include "SettingsWindow.h"
 #include "LogOutputDevice.h"
+#include "LogStorage.h"
+#include "LogViewerWindow.h"
 #include "InstallerHandler.h"
 #include "BuilderHandler.h"
 #include "DatabaseProvider.h"
+#include "CatalogCache.h"
+#include "StringPool.h"
 
 #include <QMessageBox>
 #include <QLabel>
-#include <QScrollBar>
+#include <QStandardPaths>
 
 // Widget constructor, taking pointer to parent widget
 // When parent widget is being deleted, all its children are deleted automatically
@@ -21,11 +25,16 @@ MainWindow::MainWindow(QWidget *parent)
 	, log_output_device(new LogOutputDevice(this))
 	, login_window(new LoginWindow(this))
 	, settings_window(new SettingsWindow(this))
+	, log_viewer_window(new LogViewerWindow(this))
 	, settings("spbu-dreamteam", "Patcher")
 {
 	ui->setupUi(this);
 	ui->tab_widget->setCurrentWidget(ui->builder_tab);
 	ReadSettings();
+	CatalogCache::SetSnapshotDirectory(QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation)
+		+ "/" + settings.organizationName() + "/" + settings.applicationName() + "/catalog");
+	LogStorage::SetDirectory(QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation)
+		+ "/" + settings.organizationName() + "/" + settings.applicationName() + "/logs");
 	log_output_device->SetTextEdit(ui->log_text_edit);
 	log_output_device->open(QIODevice::WriteOnly);
 	InstallerHandler::SetOutputDevice(*log_output_device);
@@ -34,16 +43,25 @@ MainWindow::MainWindow(QWidget *parent)
 	connect_action = new QAction(QIcon(":/images/addDatabase.svg"), "Connect to database...", this);
 	disconnect_action = new QAction(QIcon(":/images/removeDatabase.svg"), "Disconnect", this);
 	disconnect_action->setDisabled(true);
+	refresh_catalog_action = new QAction(QIcon(":/images/reset.svg"), "Refresh catalog", this);
+	refresh_catalog_action->setDisabled(true);
 	database_information = new QLabel("Connect to database!", this);
 
 	ui->database_menu->addAction(connect_action);
 	ui->database_menu->addAction(disconnect_action);
+	ui->database_menu->addAction(refresh_catalog_action);
 
 	connect_action->setShortcut(QKeySequence("Ctrl+O"));
 	disconnect_action->setShortcut(QKeySequence("Ctrl+W"));
+	refresh_catalog_action->setShortcut(QKeySequence("F5"));
 
 	ui->view_menu->addAction(QIcon(":/images/hammer.svg"),"Build", [=]() { ui->tab_widget->setCurrentWidget(ui->builder_tab); }, QKeySequence("Ctrl+B"));
 	ui->view_menu->addAction(QIcon(":/images/install.svg"), "Install", [=]() { ui->tab_widget->setCurrentWidget(ui->installer_tab); }, QKeySequence("Ctrl+I"));
+	ui->view_menu->addAction("Log history...", [=]()
+	{
+		log_output_device->Flush();
+		log_viewer_window->OpenLogViewer();
+	}, QKeySequence("Ctrl+L"));
 	ui->view_menu->addAction("Settings...", [=]() { settings_window->OpenSettingsDialog(settings); });
 	ui->view_menu->addAction("About...", [=]()
 	{
@@ -59,10 +77,12 @@ MainWindow::MainWindow(QWidget *parent)
 	connect(login_window, &LoginWindow::ConnectButtonClicked, this, &MainWindow::OnDialogConnectButtonClicked);
 	connect(connect_action, &QAction::triggered, this, &MainWindow::OnConnectionRequested);
 	connect(disconnect_action, &QAction::triggered, this, &MainWindow::OnDisconnectButtonClicked);
+	connect(refresh_catalog_action, &QAction::triggered, this, &MainWindow::OnRefreshCatalogTriggered);
 	connect(ui->builder_tab, &BuilderWidget::ConnectionRequested, this, &MainWindow::OnConnectionRequested);
 	connect(ui->installer_tab, &InstallerWidget::ConnectionRequested, this, &MainWindow::OnConnectionRequested);
 	connect(this, &MainWindow::Connected, ui->builder_tab, &BuilderWidget::OnConnected);
 	connect(this, &MainWindow::DisconnectionStarted, ui->builder_tab, &BuilderWidget::OnDisconnectionStarted);
+	connect(this, &MainWindow::CatalogRefreshed, ui->builder_tab, &BuilderWidget::OnCatalogRefreshed);
 	connect(this, &MainWindow::DisconnectionStarted, ui->installer_tab, &InstallerWidget::OnDisconnectionStarted);
 	connect(settings_window, &SettingsWindow::SaveButtonClicked, [&]()
 	{
@@ -72,14 +92,18 @@ MainWindow::MainWindow(QWidget *parent)
 }
 
 // Destructor with ui object deleting and database disconnection
+// Log text waiting for the flush timer is written to disk, so the last messages are kept in log history
 MainWindow::~MainWindow()
 {
 	if (DatabaseProvider::IsConnected())
 	{
 		emit DisconnectionStarted();
+		CatalogCache::StopUpdate();
 		DatabaseProvider::Disconnect();
 	}
 
+	log_output_device->Flush();
+	LogStorage::Close();
 	delete ui;
 }
 
@@ -96,14 +120,28 @@ void MainWindow::OnDialogConnectButtonClicked()
 			+ DatabaseProvider::User() + "\"");
 		connect_action->setDisabled(true);
 		disconnect_action->setEnabled(true);
+		refresh_catalog_action->setEnabled(true);
 		login_window->Clear();
 		login_window->close();
+
+		// Snapshot kept since the last connection to the same database is refreshed incrementally,
+		// otherwise saved snapshot makes completion available at once, it is brought up to date in background
+		if (!CatalogCache::IsLoadedForCurrentDatabase())
+		{
+			CatalogCache::Invalidate();
+
+			if (CatalogCache::LoadSnapshot())
+			{
+				WriteLog(QString("Catalog snapshot loaded from disk: %1 objects").arg(CatalogCache::Count()));
+			}
+		}
+
 		emit Connected();
+		UpdateCatalog();
 	}
 	else
 	{
-		ui->log_text_edit->append(error_message);
-		ui->log_text_edit->verticalScrollBar()->setValue(ui->log_text_edit->verticalScrollBar()->maximum());
+		WriteLog(error_message);
 		QApplication::beep();
 		QMessageBox::warning(this, "Connection error"
 				, "Connection error. See log for details", QMessageBox::Ok, QMessageBox::Ok);
@@ -129,14 +167,59 @@ void MainWindow::OnDisconnectButtonClicked()
 	}
 
 	emit DisconnectionStarted();
+	CatalogCache::StopUpdate();
 	DatabaseProvider::Disconnect();
 	database_information->setText("Connect to database!");
 	connect_action->setEnabled(true);
 	disconnect_action->setDisabled(true);
+	refresh_catalog_action->setDisabled(true);
+}
+
+// Handles refresh catalog action
+void MainWindow::OnRefreshCatalogTriggered()
+{
+	if (!DatabaseProvider::IsConnected())
+	{
+		return;
+	}
+
+	UpdateCatalog();
+}
+
+// Launches catalog cache update in background
+// When it is finished, writes cache statistics to log and updates widgets which depend on the cache
+// Widgets fall back to database queries while cache is not loaded
+void MainWindow::UpdateCatalog()
+{
+	CatalogCache::Update(this, [this](bool is_successful, const QString &error_message)
+	{
+		if (!is_successful)
+		{
+			WriteLog("Catalog cache is not updated: " + error_message);
+			return;
+		}
+
+		WriteLog(QString("Catalog cache updated: %1 objects, %2 rows transferred (cache hits: %3, misses: %4)")
+			.arg(CatalogCache::Count()).arg(CatalogCache::TransferredRows()).arg(CatalogCache::Hits()).arg(CatalogCache::Misses()));
+		WriteLog(QString("String pool: %1 strings, %2 requests, %3 bytes saved")
+			.arg(StringPool::Count()).arg(StringPool::Requests()).arg(StringPool::BytesSaved()));
+		emit CatalogRefreshed();
+	});
+}
+
+// Writes message to log, it is shown in order with module output
+void MainWindow::WriteLog(const QString &message)
+{
+	log_output_device->WriteMessage(message);
 }
 
 // Reads saved settings for the application
 void MainWindow::ReadSettings()
 {
 	BuilderHandler::SetTemplatesFile(settings.value("templates", "Templates.ini").toString());
+	DatabaseProvider::SetPoolLimits(settings.value("connection_pool/minimum", 1).toInt()
+		, settings.value("connection_pool/maximum", 4).toInt(), settings.value("connection_pool/idle_timeout", 60000).toInt());
+	InstallerHandler::SetTimeouts(settings.value("installer/install_timeout", 0).toInt()
+		, settings.value("installer/check_timeout", 0).toInt());
+	InstallerHandler::SetInProcessCheckEnabled(settings.value("dependency_check/in_process", true).toBool());
 }
\ No newline at end of file
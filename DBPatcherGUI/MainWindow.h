@@ -8,6 +8,7 @@ class QLabel;
 class LoginWindow;
 class SettingsWindow;
 class LogOutputDevice;
+class LogViewerWindow;
 
 // Namespace required by Qt for loading .ui form file
 namespace Ui
@@ -34,18 +35,25 @@ private:
 	// Actions shown in main menu
 	QAction *connect_action;
 	QAction *disconnect_action;
+	QAction *refresh_catalog_action;
 	// Label showing connection information
 	QLabel *database_information;
 	// Settings dialog
 	SettingsWindow *settings_window;
+	// Log history dialog
+	LogViewerWindow *log_viewer_window;
 	// Settings object
 	QSettings settings;
 	void ReadSettings();
+	void UpdateCatalog();
+	void WriteLog(const QString &message);
 signals:
 	void Connected();
 	void DisconnectionStarted();
+	void CatalogRefreshed();
 private slots:
 	void OnDialogConnectButtonClicked();
 	void OnConnectionRequested();
 	void OnDisconnectButtonClicked();
+	void OnRefreshCatalogTriggered();
 };
\ No newline at end of file
@@ -0,0 +1,204 @@
+#include "MappedListFile.h"
+
+#include <QHash>
+#include <QTextCodec>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+// Constructor
+MappedListFile::MappedListFile(ListFileParser::Formats format)
+	: format(format)
+	, data(nullptr)
+	, size(0)
+	, is_name_index_built(false)
+	, codec(QTextCodec::codecForLocale())
+	, parser(format)
+{
+}
+
+// Destructor, unmaps the file
+MappedListFile::~MappedListFile()
+{
+	if (data)
+	{
+		file.unmap(data);
+	}
+}
+
+// Checks if file text can be split into lines by bytes, that is it is not in UTF-16 or UTF-32
+// Only the byte order mark is read, so the check is cheap enough to choose between mapping and parsing
+bool MappedListFile::CanMap(const QString &path)
+{
+	QFile checked_file(path);
+
+	if (!checked_file.open(QIODevice::ReadOnly))
+	{
+		return false;
+	}
+
+	const auto head = checked_file.read(4);
+	return head.startsWith("\xEF\xBB\xBF") || QTextCodec::codecForUtfText(head, nullptr) == nullptr;
+}
+
+// Maps file and builds index of its non-empty lines
+// Lines are not decoded, an incorrect one is reported when its object is requested
+// Lines are found by bytes, so files in UTF-16 and UTF-32 are not supported and are parsed by ListFileParser instead
+bool MappedListFile::Open(const QString &path, QString &error_message)
+{
+	file.setFileName(path);
+
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		error_message = file.errorString();
+		return false;
+	}
+
+	size = file.size();
+
+	if (size > std::numeric_limits<quint32>::max())
+	{
+		error_message = "file is too large to be mapped";
+		return false;
+	}
+
+	data = size == 0 ? nullptr : file.map(0, size);
+
+	if (size != 0 && !data)
+	{
+		error_message = file.errorString();
+		return false;
+	}
+
+	qint64 begin = 0;
+	const auto head = QByteArray::fromRawData(reinterpret_cast<const char*>(data), static_cast<int>(qMin<qint64>(size, 4)));
+	codec = QTextCodec::codecForUtfText(head, QTextCodec::codecForLocale());
+
+	if (size >= 3 && data[0] == 0xEF && data[1] == 0xBB && data[2] == 0xBF)
+	{
+		begin = 3;
+	}
+	else if (codec != QTextCodec::codecForLocale())
+	{
+		error_message = "unsupported file encoding";
+		return false;
+	}
+
+	line_offsets.clear();
+	name_index.clear();
+	is_name_index_built = false;
+	auto line_begin = begin;
+	auto has_content = false;
+
+	for (auto i = begin; i < size; ++i)
+	{
+		const auto current = data[i];
+
+		if (current == '\n')
+		{
+			if (has_content)
+			{
+				line_offsets.append(static_cast<quint32>(line_begin));
+			}
+
+			line_begin = i + 1;
+			has_content = false;
+		}
+		else if (current != ' ' && current != '\r')
+		{
+			has_content = true;
+		}
+	}
+
+	if (has_content)
+	{
+		line_offsets.append(static_cast<quint32>(line_begin));
+	}
+
+	line_offsets.squeeze();
+	return true;
+}
+
+// Returns amount of objects in the file
+int MappedListFile::Count() const
+{
+	return line_offsets.count();
+}
+
+// Getter for format
+ListFileParser::Formats MappedListFile::GetFormat() const
+{
+	return format;
+}
+
+// Decodes object by its index
+// Line number is counted only for error message, as it needs a scan of the file
+bool MappedListFile::Row(int index, ListFileRow &row, QString &error_message) const
+{
+	const auto line = Line(index);
+
+	if (parser.ParseRow(line, 0, row))
+	{
+		return true;
+	}
+
+	parser.ParseRow(line, LineNumber(index), row);
+	error_message = parser.GetErrorMessage();
+	return false;
+}
+
+// Returns indexes of objects which may have the given name, function name is given without parameters
+// Names are compared by their hashes, so objects are to be decoded to confirm the match
+QVector<int> MappedListFile::FindRows(const QString &name) const
+{
+	if (!is_name_index_built)
+	{
+		BuildNameIndex();
+	}
+
+	const auto hash = static_cast<quint64>(qHash(name)) << 32;
+	QVector<int> found_rows;
+
+	for (auto i = std::lower_bound(name_index.begin(), name_index.end(), hash); i != name_index.end() && (*i & 0xFFFFFFFF00000000) == hash; ++i)
+	{
+		found_rows.append(static_cast<int>(*i & 0xFFFFFFFF));
+	}
+
+	return found_rows;
+}
+
+// Returns decoded text of line by object index
+QString MappedListFile::Line(int index) const
+{
+	const auto begin = reinterpret_cast<const char*>(data) + line_offsets.at(index);
+	const auto found = static_cast<const char*>(std::memchr(begin, '\n', static_cast<size_t>(size - line_offsets.at(index))));
+	const auto length = found ? found - begin : size - line_offsets.at(index);
+	return codec->toUnicode(begin, static_cast<int>(length));
+}
+
+// Returns number of line in file by object index, starting from 1
+int MappedListFile::LineNumber(int index) const
+{
+	const auto begin = reinterpret_cast<const char*>(data);
+	return static_cast<int>(std::count(begin, begin + line_offsets.at(index), '\n')) + 1;
+}
+
+// Decodes all lines once and keeps hashes of their object names
+// Incorrect lines are left out, they cannot match any name
+void MappedListFile::BuildNameIndex() const
+{
+	name_index.clear();
+	name_index.reserve(line_offsets.count());
+	ListFileRow row;
+
+	for (auto i = 0; i < line_offsets.count(); ++i)
+	{
+		if (parser.ParseRow(Line(i), 0, row))
+		{
+			name_index.append(static_cast<quint64>(qHash(row.name)) << 32 | static_cast<quint64>(i));
+		}
+	}
+
+	std::sort(name_index.begin(), name_index.end());
+	is_name_index_built = true;
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "ListFileParser.h"
+
+#include <QFile>
+#include <QVector>
+
+class QTextCodec;
+
+// Class implementing lazily decoded list file
+// File is memory-mapped and only offsets of its non-empty lines are collected on opening,
+// objects are decoded by line when they are requested
+class MappedListFile
+{
+public:
+	MappedListFile(ListFileParser::Formats format);
+	~MappedListFile();
+	static bool CanMap(const QString &path);
+	bool Open(const QString &path, QString &error_message);
+	int Count() const;
+	ListFileParser::Formats GetFormat() const;
+	bool Row(int index, ListFileRow &row, QString &error_message) const;
+	QVector<int> FindRows(const QString &name) const;
+private:
+	// Format of the file
+	ListFileParser::Formats format;
+	// Mapped file and its contents
+	QFile file;
+	uchar *data;
+	qint64 size;
+	// Offsets of non-empty lines
+	QVector<quint32> line_offsets;
+	// Hashes of object names in high halves and indexes of their lines in low ones, sorted for lookup
+	// It is built on the first lookup, so opening does not decode the file
+	mutable QVector<quint64> name_index;
+	mutable bool is_name_index_built;
+	// Codec of file text
+	QTextCodec *codec;
+	// Parser of single lines
+	mutable ListFileParser parser;
+	QString Line(int index) const;
+	int LineNumber(int index) const;
+	void BuildNameIndex() const;
+};
\ No newline at end of file
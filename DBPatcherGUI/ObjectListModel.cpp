@@ -0,0 +1,799 @@
+#include "ObjectListModel.h"
+#include "ObjectTypes.h"
+#include "PatchList.h"
+#include "PatchListElement.h"
+#include "StringPool.h"
+#include "MappedListFile.h"
+
+#include <QIcon>
+#include <algorithm>
+#include <numeric>
+
+const QHash<int, QString> ObjectListModel::status_icons = QHash<int, QString>({ {waiting_for_check, ":/images/unchecked.svg"}
+		, {satisfied, ":/images/checked.svg"}, {not_satisfied, ":/images/error.svg"} });
+const int ObjectListModel::decoded_row_cache_size = 4096;
+
+// Constructor
+ObjectListModel::ObjectListModel(bool has_status_column, QObject *parent)
+	: QAbstractTableModel(parent)
+	, has_status_column(has_status_column)
+	, checked_count(0)
+	, are_all_satisfied(true)
+	, decoded_rows(decoded_row_cache_size)
+	, is_list_order(true)
+	, is_source_error_reported(false)
+{
+}
+
+// Destructor
+ObjectListModel::~ObjectListModel()
+{
+}
+
+// Returns amount of objects in list
+int ObjectListModel::rowCount(const QModelIndex &parent) const
+{
+	if (parent.isValid())
+	{
+		return 0;
+	}
+
+	return source ? entries.count() : rows.count();
+}
+
+// Returns amount of columns
+int ObjectListModel::columnCount(const QModelIndex &parent) const
+{
+	return parent.isValid() ? 0 : (has_status_column ? status_column + 1 : name_column + 1);
+}
+
+// Returns data of object for view
+// Type column gives type index in user role, status column gives check status in user role
+QVariant ObjectListModel::data(const QModelIndex &index, int role) const
+{
+	if (!index.isValid() || index.row() >= rowCount())
+	{
+		return QVariant();
+	}
+
+	const auto row = Row(index.row());
+
+	switch (index.column())
+	{
+		case type_column:
+		{
+			if (role == Qt::DisplayRole)
+			{
+				return ObjectTypes::type_names.value(row.type);
+			}
+
+			if (role == Qt::DecorationRole)
+			{
+				return TypeIcon(row.type);
+			}
+
+			if (role == Qt::UserRole)
+			{
+				return row.type;
+			}
+
+			break;
+		}
+		case schema_column:
+		{
+			if (role == Qt::DisplayRole)
+			{
+				return StringPool::Value(row.schema);
+			}
+
+			break;
+		}
+		case name_column:
+		{
+			if (role == Qt::DisplayRole)
+			{
+				return row.name;
+			}
+
+			break;
+		}
+		case status_column:
+		{
+			if (role == Qt::DecorationRole)
+			{
+				return StatusIcon(row.status);
+			}
+
+			if (role == Qt::CheckStateRole)
+			{
+				return row.is_checked ? Qt::Checked : Qt::Unchecked;
+			}
+
+			if (role == Qt::UserRole)
+			{
+				return row.status;
+			}
+
+			break;
+		}
+		default:
+		{
+			break;
+		}
+	}
+
+	return QVariant();
+}
+
+// Returns column titles
+QVariant ObjectListModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+	{
+		return QVariant();
+	}
+
+	switch (section)
+	{
+		case type_column:
+		{
+			return "Type";
+		}
+		case schema_column:
+		{
+			return "Schema";
+		}
+		case name_column:
+		{
+			return "Name";
+		}
+		case status_column:
+		{
+			return "Status";
+		}
+		default:
+		{
+			return QVariant();
+		}
+	}
+}
+
+// Returns item flags
+// Draggable rows can be moved inside the list, drops are accepted only between rows
+Qt::ItemFlags ObjectListModel::flags(const QModelIndex &index) const
+{
+	if (!index.isValid())
+	{
+		return Qt::ItemIsDropEnabled;
+	}
+
+	if (Row(index.row()).is_draggable)
+	{
+		return Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemIsDragEnabled;
+	}
+
+	return Qt::ItemIsEnabled;
+}
+
+// Returns drop actions supported by the model
+Qt::DropActions ObjectListModel::supportedDropActions() const
+{
+	return Qt::MoveAction;
+}
+
+// Sorts objects by column
+// Persistent indexes follow their rows, so selection is kept
+// Mapped file is sorted by its entries, lines are decoded once for comparison and not kept, status needs no decoding
+void ObjectListModel::sort(int column, Qt::SortOrder order)
+{
+	emit layoutAboutToBeChanged();
+
+	QVector<ObjectListRow> mapped_rows;
+
+	if (source)
+	{
+		mapped_rows.reserve(entries.count());
+
+		for (const auto entry : entries)
+		{
+			mapped_rows.append(column == status_column && entry < LineCount()
+				? ObjectListRow{ ObjectTypes::type_count, -1, QString(), source_states.at(entry).status, false, false } : Entry(entry));
+		}
+	}
+
+	const auto &compared_rows = source ? mapped_rows : rows;
+	QVector<int> order_of_rows(compared_rows.count());
+	std::iota(order_of_rows.begin(), order_of_rows.end(), 0);
+
+	// Schema names are taken from the pool once, not on every comparison
+	QHash<int, QString> schema_names;
+
+	if (column == schema_column)
+	{
+		for (const auto &current : compared_rows)
+		{
+			if (!schema_names.contains(current.schema))
+			{
+				schema_names.insert(current.schema, StringPool::Value(current.schema));
+			}
+		}
+	}
+
+	std::stable_sort(order_of_rows.begin(), order_of_rows.end(), [&](int left, int right)
+	{
+		const auto &first = compared_rows.at(order == Qt::AscendingOrder ? left : right);
+		const auto &second = compared_rows.at(order == Qt::AscendingOrder ? right : left);
+
+		switch (column)
+		{
+			case type_column:
+			{
+				return ObjectTypes::type_names.value(first.type) < ObjectTypes::type_names.value(second.type);
+			}
+			case schema_column:
+			{
+				return schema_names.value(first.schema) < schema_names.value(second.schema);
+			}
+			case name_column:
+			{
+				return first.name < second.name;
+			}
+			case status_column:
+			{
+				return first.status < second.status;
+			}
+			default:
+			{
+				return false;
+			}
+		}
+	});
+
+	QVector<int> new_positions(order_of_rows.count());
+
+	for (auto i = 0; i < order_of_rows.count(); ++i)
+	{
+		new_positions[order_of_rows.at(i)] = i;
+	}
+
+	if (source)
+	{
+		QVector<int> sorted_entries;
+		sorted_entries.reserve(entries.count());
+
+		for (const auto current : order_of_rows)
+		{
+			sorted_entries.append(entries.at(current));
+		}
+
+		entries = sorted_entries;
+		is_list_order = false;
+	}
+	else
+	{
+		QVector<ObjectListRow> sorted_rows;
+		sorted_rows.reserve(rows.count());
+
+		for (const auto current : order_of_rows)
+		{
+			sorted_rows.append(rows.at(current));
+		}
+
+		rows = sorted_rows;
+	}
+
+	QModelIndexList new_indexes;
+	const auto old_indexes = persistentIndexList();
+
+	for (const auto &current : old_indexes)
+	{
+		new_indexes.append(index(new_positions.at(current.row()), current.column()));
+	}
+
+	changePersistentIndexList(old_indexes, new_indexes);
+	emit layoutChanged();
+}
+
+// Adds a new object to list, marking it as waiting for check
+// Row added to mapped file is kept in the array and shown by a new entry
+void ObjectListModel::Add(int type_index, const QString &schema, const QString &name, bool is_draggable)
+{
+	beginInsertRows(QModelIndex(), rowCount(), rowCount());
+	rows.append(ObjectListRow{ type_index, StringPool::Intern(schema), name, waiting_for_check, false, is_draggable });
+	IndexRow(rows.last());
+
+	if (source)
+	{
+		entries.append(LineCount() + rows.count() - 1);
+		list_entries.clear();
+	}
+
+	endInsertRows();
+}
+
+// Adds a batch of objects to list with one update
+void ObjectListModel::Add(const PatchList &objects, bool is_draggable)
+{
+	if (objects.Count() == 0)
+	{
+		return;
+	}
+
+	beginInsertRows(QModelIndex(), rowCount(), rowCount() + objects.Count() - 1);
+	rows.reserve(rows.count() + objects.Count());
+
+	for (const auto current : objects)
+	{
+		rows.append(ObjectListRow{ current.GetType(), StringPool::Intern(current.GetSchema()), current.GetName(), waiting_for_check, false, is_draggable });
+		IndexRow(rows.last());
+
+		if (source)
+		{
+			entries.append(LineCount() + rows.count() - 1);
+		}
+	}
+
+	list_entries.clear();
+	endInsertRows();
+}
+
+// Checks object for existence in the list
+// Lookup goes through the object index, so it takes constant time, lines of mapped file are found by their name hashes
+bool ObjectListModel::Contains(int type_index, const QString &schema, const QString &name) const
+{
+	if (source)
+	{
+		const auto is_signature = source->GetFormat() == ListFileParser::object_list_format && type_index == ObjectTypes::function;
+
+		for (const auto line : source->FindRows(is_signature ? name.left(name.indexOf('(')) : name))
+		{
+			if (removed_lines.testBit(line))
+			{
+				continue;
+			}
+
+			const auto current = DecodeLine(line);
+
+			if (current.type == type_index && current.name == name && StringPool::Value(current.schema) == schema)
+			{
+				return true;
+			}
+		}
+	}
+
+	const auto schema_index = StringPool::Find(schema);
+
+	if (schema_index == -1)
+	{
+		return false;
+	}
+
+	return object_index.contains(ObjectListKey{ type_index, schema_index, name });
+}
+
+// Removes object from list
+// Line of mapped file is marked as removed, row added to it stays in the array without its entry
+void ObjectListModel::Remove(int row)
+{
+	if (row < 0 || row >= rowCount())
+	{
+		return;
+	}
+
+	beginRemoveRows(QModelIndex(), row, row);
+	const auto entry = RowEntry(row);
+	checked_count -= State(entry).is_checked ? 1 : 0;
+
+	if (entry < LineCount())
+	{
+		removed_lines.setBit(entry);
+	}
+	else
+	{
+		UnindexRow(rows.at(entry - LineCount()));
+	}
+
+	if (source)
+	{
+		entries.remove(row);
+		list_entries.clear();
+	}
+	else
+	{
+		rows.remove(row);
+	}
+
+	endRemoveRows();
+}
+
+// Moves object to another position, to_row is its index after the move
+bool ObjectListModel::Move(int from_row, int to_row)
+{
+	if (from_row < 0 || from_row >= rowCount() || to_row < 0 || to_row >= rowCount() || from_row == to_row)
+	{
+		return false;
+	}
+
+	// Destination of beginMoveRows is the row before which the moved one is inserted
+	beginMoveRows(QModelIndex(), from_row, from_row, QModelIndex(), to_row > from_row ? to_row + 1 : to_row);
+
+	if (source)
+	{
+		const auto moved_entry = entries.at(from_row);
+		entries.remove(from_row);
+		entries.insert(to_row, moved_entry);
+		is_list_order = false;
+	}
+	else
+	{
+		const auto moved_row = rows.at(from_row);
+		rows.remove(from_row);
+		rows.insert(to_row, moved_row);
+	}
+
+	endMoveRows();
+	return true;
+}
+
+// Clears current list
+void ObjectListModel::Clear()
+{
+	beginResetModel();
+	source.reset();
+	decoded_rows.clear();
+	source_states.clear();
+	entries.clear();
+	removed_lines.clear();
+	list_entries.clear();
+	rows.clear();
+	object_index.clear();
+	checked_count = 0;
+	are_all_satisfied = true;
+	endResetModel();
+}
+
+// Getter for object type
+int ObjectListModel::GetType(int row) const
+{
+	return Row(row).type;
+}
+
+// Getter for object schema
+QString ObjectListModel::GetSchema(int row) const
+{
+	return StringPool::Value(Row(row).schema);
+}
+
+// Getter for object name
+QString ObjectListModel::GetName(int row) const
+{
+	return Row(row).name;
+}
+
+// Returns objects of the list in list order
+// List order of mapped file is order of its lines whatever the sorting, as checks and reports of the file address them,
+// added rows follow the lines, order of other lists is current one
+PatchList ObjectListModel::GetObjects() const
+{
+	PatchList objects;
+	objects.Reserve(rowCount());
+
+	for (auto i = 0; i < rowCount(); ++i)
+	{
+		const auto current = Entry(ListEntry(i));
+		objects.Add(current.type, StringPool::Value(current.schema), current.name);
+	}
+
+	return objects;
+}
+
+// Marks dependencies in list as satisfied/not satisfied by check result bit array in list order
+bool ObjectListModel::SetCheckStatus(const QBitArray &check_result)
+{
+	if (check_result.count() != rowCount())
+	{
+		return false;
+	}
+
+	are_all_satisfied = true;
+	return SetCheckStatus(0, check_result);
+}
+
+// Sets check status of a batch of rows in list order starting from the given one, other rows keep their status
+// Lets dependency check results be shown as they come, with one view update for a batch
+// Rows of sorted mapped file are not contiguous, so the whole column is updated then, views repaint only visible rows
+bool ObjectListModel::SetCheckStatus(int first_row, const QBitArray &check_result)
+{
+	if (first_row < 0 || first_row + check_result.count() > rowCount())
+	{
+		return false;
+	}
+
+	for (auto i = 0; i < check_result.count(); ++i)
+	{
+		are_all_satisfied = are_all_satisfied && check_result[i];
+		SetState(ListEntry(first_row + i), ObjectListState{ check_result[i] ? satisfied : not_satisfied, check_result[i] });
+	}
+
+	if (check_result.isEmpty())
+	{
+		return true;
+	}
+
+	if (source && !is_list_order)
+	{
+		emit dataChanged(index(0, status_column), index(rowCount() - 1, status_column));
+	}
+	else
+	{
+		emit dataChanged(index(first_row, status_column), index(first_row + check_result.count() - 1, status_column));
+	}
+
+	return true;
+}
+
+// Clears current list check state
+void ObjectListModel::ClearCheck()
+{
+	for (auto &current : rows)
+	{
+		current.is_checked = false;
+		current.status = waiting_for_check;
+	}
+
+	source_states.fill(ObjectListState{ waiting_for_check, false });
+	checked_count = 0;
+	are_all_satisfied = true;
+
+	if (rowCount() != 0)
+	{
+		emit dataChanged(index(0, status_column), index(rowCount() - 1, status_column));
+	}
+}
+
+// Switches manual confirmation of a checked dependency
+// Returns false if dependency is waiting for check
+bool ObjectListModel::ToggleCheck(int row)
+{
+	if (row < 0 || row >= rowCount())
+	{
+		return false;
+	}
+
+	const auto entry = RowEntry(row);
+	const auto state = State(entry);
+
+	if (state.status == waiting_for_check)
+	{
+		return false;
+	}
+
+	SetState(entry, ObjectListState{ state.status, !state.is_checked });
+	emit dataChanged(index(row, status_column), index(row, status_column));
+	return true;
+}
+
+// Getter for checked_count
+int ObjectListModel::GetCheckedCount() const
+{
+	return checked_count;
+}
+
+// Getter for are_all_satisfied
+bool ObjectListModel::GetAreAllSatisfied() const
+{
+	return are_all_satisfied;
+}
+
+// Shows mapped file instead of current rows
+// Model takes ownership of the file, rows are not decoded until views ask for them
+void ObjectListModel::SetSource(std::unique_ptr<MappedListFile> source)
+{
+	beginResetModel();
+	rows.clear();
+	object_index.clear();
+	decoded_rows.clear();
+	list_entries.clear();
+	checked_count = 0;
+	are_all_satisfied = true;
+	this->source = std::move(source);
+	source_states.fill(ObjectListState{ waiting_for_check, false }, this->source->Count());
+	removed_lines = QBitArray(this->source->Count());
+	entries.resize(this->source->Count());
+	std::iota(entries.begin(), entries.end(), 0);
+	is_list_order = true;
+	is_source_error_reported = false;
+	endResetModel();
+}
+
+// Checks if model shows all lines of mapped file and no other rows, so the file can be used instead of the list
+// Sorted file is still mapped, as its list order is kept
+bool ObjectListModel::IsMapped() const
+{
+	return source && rows.isEmpty() && entries.count() == LineCount();
+}
+
+// Returns row by its index, lines of mapped file are decoded and cached
+ObjectListRow ObjectListModel::Row(int row) const
+{
+	const auto entry = RowEntry(row);
+
+	if (entry >= LineCount())
+	{
+		return rows.at(entry - LineCount());
+	}
+
+	auto cached = decoded_rows.object(entry);
+
+	if (!cached)
+	{
+		cached = new ObjectListRow(DecodeLine(entry));
+		decoded_rows.insert(entry, cached);
+	}
+
+	auto current = *cached;
+	current.status = source_states.at(entry).status;
+	current.is_checked = source_states.at(entry).is_checked;
+	return current;
+}
+
+// Returns row by its entry without caching, used when all rows are read once
+ObjectListRow ObjectListModel::Entry(int entry) const
+{
+	if (entry >= LineCount())
+	{
+		return rows.at(entry - LineCount());
+	}
+
+	auto current = DecodeLine(entry);
+	current.status = source_states.at(entry).status;
+	current.is_checked = source_states.at(entry).is_checked;
+	return current;
+}
+
+// Decodes line of mapped file without its check state
+// Functions of object list are named by their signature as in the patch list
+// Incorrect line is shown by its error message and the first one is reported after the view is updated
+ObjectListRow ObjectListModel::DecodeLine(int line) const
+{
+	ListFileRow parsed;
+	QString error_message;
+
+	if (!source->Row(line, parsed, error_message))
+	{
+		if (!is_source_error_reported)
+		{
+			is_source_error_reported = true;
+			QMetaObject::invokeMethod(const_cast<ObjectListModel*>(this), [this, error_message]()
+			{
+				emit SourceLineInvalid(error_message);
+			}, Qt::QueuedConnection);
+		}
+
+		return ObjectListRow{ ObjectTypes::type_count, StringPool::Intern(""), error_message, waiting_for_check, false, false };
+	}
+
+	if (source->GetFormat() == ListFileParser::object_list_format && parsed.type == ObjectTypes::function)
+	{
+		parsed.name += "(" + parsed.parameters.join(",") + ")";
+	}
+
+	return ObjectListRow{ parsed.type, StringPool::Intern(parsed.schema), parsed.name, waiting_for_check, false, false };
+}
+
+// Returns amount of lines of mapped file, entries below it are lines and others are indexes of the array after it
+int ObjectListModel::LineCount() const
+{
+	return source ? source->Count() : 0;
+}
+
+// Returns entry shown by row, it is the row index if no file is mapped
+int ObjectListModel::RowEntry(int row) const
+{
+	return source ? entries.at(row) : row;
+}
+
+// Returns entry by its index in list order
+// Entries of mapped file are sorted only if it is reordered and some of them are removed,
+// otherwise list order is order of rows or of all entries
+int ObjectListModel::ListEntry(int index) const
+{
+	if (!source)
+	{
+		return index;
+	}
+
+	if (is_list_order)
+	{
+		return entries.at(index);
+	}
+
+	if (entries.count() == LineCount() + rows.count())
+	{
+		return index;
+	}
+
+	if (list_entries.isEmpty())
+	{
+		list_entries = entries;
+		std::sort(list_entries.begin(), list_entries.end());
+	}
+
+	return list_entries.at(index);
+}
+
+// Returns check state of entry
+ObjectListState ObjectListModel::State(int entry) const
+{
+	if (entry < LineCount())
+	{
+		return source_states.at(entry);
+	}
+
+	const auto &current = rows.at(entry - LineCount());
+	return ObjectListState{ current.status, current.is_checked };
+}
+
+// Sets check state of entry and keeps amount of checked entries
+void ObjectListModel::SetState(int entry, const ObjectListState &state)
+{
+	checked_count += (state.is_checked ? 1 : 0) - (State(entry).is_checked ? 1 : 0);
+
+	if (entry < LineCount())
+	{
+		source_states[entry] = state;
+		return;
+	}
+
+	auto &current = rows[entry - LineCount()];
+	current.status = state.status;
+	current.is_checked = state.is_checked;
+}
+
+// Adds row to object index
+void ObjectListModel::IndexRow(const ObjectListRow &row)
+{
+	++object_index[ObjectListKey{ row.type, row.schema, row.name }];
+}
+
+// Removes row from object index, the object stays indexed while the list has its other rows
+void ObjectListModel::UnindexRow(const ObjectListRow &row)
+{
+	const auto found = object_index.find(ObjectListKey{ row.type, row.schema, row.name });
+
+	if (found == object_index.end())
+	{
+		return;
+	}
+
+	if (--found.value() == 0)
+	{
+		object_index.erase(found);
+	}
+}
+
+// Returns icon of object type, icons are created once and shared by all rows
+QIcon ObjectListModel::TypeIcon(int type_index)
+{
+	static QHash<int, QIcon> icons;
+
+	if (!icons.contains(type_index))
+	{
+		icons.insert(type_index, QIcon(ObjectTypes::type_icons.value(type_index)));
+	}
+
+	return icons.value(type_index);
+}
+
+// Returns icon of dependency check status, icons are created once and shared by all rows
+QIcon ObjectListModel::StatusIcon(int status)
+{
+	static QHash<int, QIcon> icons;
+
+	if (!icons.contains(status))
+	{
+		icons.insert(status, QIcon(status_icons.value(status)));
+	}
+
+	return icons.value(status);
+}
\ No newline at end of file
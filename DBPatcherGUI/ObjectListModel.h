@@ -0,0 +1,163 @@
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QBitArray>
+#include <QCache>
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+#include <memory>
+
+class MappedListFile;
+class PatchList;
+class QIcon;
+
+// Row of object list
+// Schema is stored as a string pool handle, type name and icons are shared by all rows
+struct ObjectListRow
+{
+	// Object type index
+	int type;
+	// String pool handle of schema name
+	int schema;
+	// Object name
+	QString name;
+	// Dependency check status
+	int status;
+	// Flag showing if dependency is confirmed
+	bool is_checked;
+	// Flag showing if row can be dragged
+	bool is_draggable;
+};
+
+// Dependency check state of a line of mapped file
+struct ObjectListState
+{
+	// Dependency check status
+	int status;
+	// Flag showing if dependency is confirmed
+	bool is_checked;
+};
+
+// Key of object in duplicate index of object list
+struct ObjectListKey
+{
+	// Object type index
+	int type;
+	// String pool handle of schema name
+	int schema;
+	// Object name
+	QString name;
+};
+
+// Compares keys of object list
+inline bool operator==(const ObjectListKey &left, const ObjectListKey &right)
+{
+	return left.type == right.type && left.schema == right.schema && left.name == right.name;
+}
+
+// Hash function for key of object list
+inline uint qHash(const ObjectListKey &key, uint seed = 0)
+{
+	return qHash(key.name, seed) ^ (static_cast<uint>(key.type) << 24) ^ static_cast<uint>(key.schema);
+}
+
+// Class implementing table model of database objects for patch and dependency lists
+// Rows are kept in a contiguous array, so views ask only for visible rows and no item objects are created
+// Model can show a mapped list file instead, then rows are decoded when views ask for them, while check states,
+// order of rows and added rows are kept aside, so the file is not decoded in whole when the list is changed
+class ObjectListModel : public QAbstractTableModel
+{
+	Q_OBJECT
+
+public:
+
+	enum ColumnIndexes
+	{
+		type_column,
+		schema_column,
+		name_column,
+		status_column
+	};
+
+	enum CheckStatus
+	{
+		waiting_for_check,
+		satisfied,
+		not_satisfied
+	};
+
+	ObjectListModel(bool has_status_column, QObject *parent = nullptr);
+	~ObjectListModel() override;
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+	QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+	Qt::ItemFlags flags(const QModelIndex &index) const override;
+	Qt::DropActions supportedDropActions() const override;
+	void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+	void Add(int type_index, const QString &schema, const QString &name, bool is_draggable);
+	void Add(const PatchList &objects, bool is_draggable);
+	bool Contains(int type_index, const QString &schema, const QString &name) const;
+	void Remove(int row);
+	bool Move(int from_row, int to_row);
+	void Clear();
+	void SetSource(std::unique_ptr<MappedListFile> source);
+	bool IsMapped() const;
+	int GetType(int row) const;
+	QString GetSchema(int row) const;
+	QString GetName(int row) const;
+	PatchList GetObjects() const;
+	bool SetCheckStatus(const QBitArray &check_result);
+	bool SetCheckStatus(int first_row, const QBitArray &check_result);
+	void ClearCheck();
+	bool ToggleCheck(int row);
+	int GetCheckedCount() const;
+	bool GetAreAllSatisfied() const;
+private:
+	// Flag showing if the model has dependency status column
+	bool has_status_column;
+	// Rows of the list
+	QVector<ObjectListRow> rows;
+	// Amount of rows for each object, makes duplicate check independent of list size
+	// Reordering does not change it, so only adding and removing rows update the index
+	QHash<ObjectListKey, int> object_index;
+	// Amount of checked (marked) dependencies in list
+	int checked_count;
+	// Flag showing if all dependencies are satisfied
+	bool are_all_satisfied;
+	// Mapped file shown instead of rows and its recently decoded lines
+	std::unique_ptr<MappedListFile> source;
+	mutable QCache<int, ObjectListRow> decoded_rows;
+	// Check states of lines of mapped file
+	QVector<ObjectListState> source_states;
+	// Entries shown by rows of mapped file: its lines, then rows added after it was opened
+	// Sorting and moving reorder entries, removing drops them, added rows stay in the array when removed
+	QVector<int> entries;
+	// Flags of removed lines of mapped file
+	QBitArray removed_lines;
+	// Sorted entries, list order of mapped file with removed rows, built when it is needed
+	mutable QVector<int> list_entries;
+	// Flag showing if mapped file is not sorted or reordered, so its rows are in list order
+	bool is_list_order;
+	// Flag showing if an incorrect line of mapped file is already reported
+	mutable bool is_source_error_reported;
+	// Amount of decoded rows kept in cache
+	static const int decoded_row_cache_size;
+	// Hash for status icon file paths
+	static const QHash<int, QString> status_icons;
+	ObjectListRow Row(int row) const;
+	ObjectListRow Entry(int entry) const;
+	ObjectListRow DecodeLine(int line) const;
+	int LineCount() const;
+	int RowEntry(int row) const;
+	int ListEntry(int index) const;
+	ObjectListState State(int entry) const;
+	void SetState(int entry, const ObjectListState &state);
+	void IndexRow(const ObjectListRow &row);
+	void UnindexRow(const ObjectListRow &row);
+	static QIcon TypeIcon(int type_index);
+	static QIcon StatusIcon(int status);
+signals:
+	void SourceLineInvalid(const QString &error_message);
+};
\ No newline at end of file
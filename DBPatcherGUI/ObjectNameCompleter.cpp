@@ -1,7 +1,13 @@
 #include "ObjectNameCompleter.h"
 #include "ObjectTypes.h"
+#include "CatalogCache.h"
+#include "DatabaseProvider.h"
+#include "QueryExecutor.h"
+#include "CompletionModel.h"
+#include "StringPool.h"
 
-#include <QSqlQueryModel>
+#include <QSqlDatabase>
+#include <QSqlError>
 #include <QSqlQuery>
 
 const QString ObjectNameCompleter::table_query = "SELECT DISTINCT table_name FROM information_schema.tables WHERE table_schema = ? AND table_type != 'VIEW';";
@@ -12,32 +18,121 @@ const QString ObjectNameCompleter::function_query = "SELECT r.routine_name || '(
 const QString ObjectNameCompleter::view_query = "SELECT DISTINCT table_name FROM information_schema.views WHERE table_schema = ?;";
 const QString ObjectNameCompleter::trigger_query = "SELECT DISTINCT trigger_name FROM information_schema.triggers WHERE trigger_schema = ?;";
 const QString ObjectNameCompleter::index_query = "SELECT DISTINCT indexname FROM pg_indexes WHERE schemaname = ?;";
+const int ObjectNameCompleter::result_limit = 50;
+const int ObjectNameCompleter::index_cache_limit = 32;
 
 // Constructor
 ObjectNameCompleter::ObjectNameCompleter(QObject *parent)
 	: QCompleter(parent)
 	, model(nullptr)
+	, index_cache_generation(-1)
+	, fetch_job(0)
 {
-	setCompletionRole(Qt::DisplayRole);
-	setCompletionMode(PopupCompletion);
+	setCaseSensitivity(Qt::CaseInsensitive);
+	// Model is filled with matches by Search, so completer shows it as is
+	// Object name is inserted into input, qualified name is only displayed
+	setCompletionMode(UnfilteredPopupCompletion);
+	setCompletionRole(Qt::EditRole);
+
+	connect(this, QOverload<const QModelIndex&>::of(&QCompleter::activated), this, &ObjectNameCompleter::OnActivated);
 }
 
 // Initializes completer with a new model
 void ObjectNameCompleter::Initialize()
 {
-	model = new QSqlQueryModel(this);
+	model = new CompletionModel(this);
 	setModel(model);
 }
 
 // Finishes completer usage by deleting current model
 void ObjectNameCompleter::Finish()
 {
+	CancelFetch();
 	delete model;
+	model = nullptr;
+	index = NameIndex();
+	index_cache.clear();
+}
+
+// Handles user's input
+// Fills model with best matches of text and shows them in the popup
+void ObjectNameCompleter::Search(const QString &text)
+{
+	pattern = text;
+	UpdateResults();
+
+	if (widget() && !pattern.isEmpty())
+	{
+		complete();
+	}
+}
+
+// Replaces index of names and updates matches of the last searched text without showing the popup
+// Reports fetch latency from its start to the moment the names can be completed
+void ObjectNameCompleter::SetIndex(const NameIndex &new_index)
+{
+	index = new_index;
+	UpdateResults();
+	emit Fetched(index.names.Count(), fetch_timer.nsecsElapsed() / 1000000.0);
+}
+
+// Fills model with best matches of the last searched text
+void ObjectNameCompleter::UpdateResults()
+{
+	if (!model)
+	{
+		return;
+	}
+
+	QList<CompletionItem> results;
+
+	for (const auto current : index.names.Search(pattern, result_limit))
+	{
+		results.append(CompletionItem{ index.names.Name(current), index.schemas.isEmpty() ? QString() : StringPool::Value(index.schemas.at(current)) });
+	}
+
+	model->SetResults(results);
 }
 
-// Fills model with object name data got from database by type and schema
+// Drops cached indexes if catalog cache has changed or there are too many of them
+// Returns false if catalog cache is not loaded and indexes cannot be built from it
+bool ObjectNameCompleter::PrepareIndexCache()
+{
+	if (!CatalogCache::IsLoaded())
+	{
+		return false;
+	}
+
+	if (index_cache_generation != CatalogCache::Generation() || index_cache.count() >= index_cache_limit)
+	{
+		index_cache.clear();
+		index_cache_generation = CatalogCache::Generation();
+	}
+
+	return true;
+}
+
+// Fills index with object names by type and schema
+// Names are taken from catalog cache or fetched from database by executor if cache is not loaded
+// A fetch which is still running is cancelled, because its result is not needed anymore
 void ObjectNameCompleter::Fetch(int type_index, const QString &schema)
 {
+	CancelFetch();
+	fetch_timer.start();
+
+	if (PrepareIndexCache())
+	{
+		const auto key = qMakePair(type_index, schema);
+
+		if (!index_cache.contains(key))
+		{
+			index_cache[key].names.Build(CatalogCache::Names(type_index, schema));
+		}
+
+		SetIndex(index_cache.value(key));
+		return;
+	}
+
 	QString query_text = "";
 
 	switch (type_index)
@@ -78,15 +173,113 @@ void ObjectNameCompleter::Fetch(int type_index, const QString &schema)
 		}
 	}
 
-	QSqlQuery fetch;
-	fetch.prepare(query_text);
-	fetch.addBindValue(schema);
-	fetch.exec();
-	model->setQuery(fetch);
+	const auto executor = DatabaseProvider::Executor("completion");
+
+	if (!executor)
+	{
+		return;
+	}
+
+	fetch_job = executor->Submit([query_text, schema](QSqlDatabase &connection)
+	{
+		QSqlQuery fetch(connection);
+		fetch.setForwardOnly(true);
+		fetch.prepare(query_text);
+		fetch.addBindValue(schema);
+
+		if (!fetch.exec())
+		{
+			return qMakePair(NameIndex(), fetch.lastError().text());
+		}
+
+		QStringList names;
+
+		while (fetch.next())
+		{
+			names.append(fetch.value(0).toString());
+		}
+
+		// Index is built in the worker thread too, so the main thread only swaps it
+		NameIndex fetched_index;
+		fetched_index.names.Build(names);
+		return qMakePair(fetched_index, QString());
+	}, model, [this](const QPair<NameIndex, QString> &fetch_result)
+	{
+		fetch_job = 0;
+		SetIndex(fetch_result.first);
+
+		if (!fetch_result.second.isEmpty())
+		{
+			emit FetchFailed(fetch_result.second);
+		}
+	});
+}
+
+// Fills index with object names of all schemas by type
+// Names are taken only from catalog cache, until it is loaded the index is empty
+void ObjectNameCompleter::FetchAllSchemas(int type_index)
+{
+	CancelFetch();
+	fetch_timer.start();
+
+	if (!PrepareIndexCache())
+	{
+		SetIndex(NameIndex());
+		return;
+	}
+
+	const auto key = qMakePair(type_index, QString());
+
+	if (!index_cache.contains(key))
+	{
+		QStringList names;
+		auto &all_schemas_index = index_cache[key];
+
+		for (const auto &current : CatalogCache::Objects(type_index))
+		{
+			names.append(current.name);
+			all_schemas_index.schemas.append(StringPool::Intern(current.schema));
+		}
+
+		all_schemas_index.names.Build(names);
+	}
+
+	SetIndex(index_cache.value(key));
 }
 
 // Clears model
 void ObjectNameCompleter::Clear()
 {
-	model->clear();
+	CancelFetch();
+	index = NameIndex();
+
+	if (model)
+	{
+		model->Clear();
+	}
+}
+
+// Cancels running database fetch
+void ObjectNameCompleter::CancelFetch()
+{
+	const auto executor = DatabaseProvider::FindExecutor("completion");
+
+	if (fetch_job != 0 && executor)
+	{
+		executor->Cancel(fetch_job);
+	}
+
+	fetch_job = 0;
+}
+
+// Handles completion acceptance
+// Reports schema of accepted result if it belongs to another schema
+void ObjectNameCompleter::OnActivated(const QModelIndex &completion_index)
+{
+	const auto schema = completion_index.data(CompletionModel::schema_role).toString();
+
+	if (!schema.isEmpty())
+	{
+		emit SchemaAccepted(schema);
+	}
 }
\ No newline at end of file
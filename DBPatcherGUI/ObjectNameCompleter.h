@@ -1,10 +1,19 @@
 #pragma once
 
+#include "TrigramIndex.h"
+
 #include <QCompleter>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QPair>
+#include <QStringList>
+#include <QVector>
 
-class QSqlQueryModel;
+class CompletionModel;
 
 // Class providing auto-completion of database object name input
+// Names are matched by trigram index, so substrings and names with typos are found too
+// In all schemas mode one index over objects of all schemas is searched and schema of accepted result is reported
 class ObjectNameCompleter : public QCompleter
 {
 	Q_OBJECT
@@ -12,12 +21,35 @@ class ObjectNameCompleter : public QCompleter
 public:
 	ObjectNameCompleter(QObject *parent = nullptr);
 	void Fetch(int type_index, const QString &schema);
+	void FetchAllSchemas(int type_index);
 	void Clear();
 	void Initialize();
 	void Finish();
+	void Search(const QString &text);
 private:
-	// Object list model
-	QSqlQueryModel *model;
+	// Trigram index over object names with schema of every name
+	// Schemas are empty if all names belong to one schema
+	struct NameIndex
+	{
+		TrigramIndex names;
+		// String pool handles of schemas of names, empty when all names belong to one schema
+		QVector<int> schemas;
+	};
+
+	// Model of best matches shown in the popup
+	CompletionModel *model;
+	// Index over names of current type and schema
+	NameIndex index;
+	// Last searched text
+	QString pattern;
+	// Indexes built from catalog cache by type and schema, all schemas index has empty schema
+	QHash<QPair<int, QString>, NameIndex> index_cache;
+	// Catalog cache generation the indexes are built from
+	int index_cache_generation;
+	// Id of running database fetch job, 0 if there is no one
+	int fetch_job;
+	// Time since the start of the last fetch
+	QElapsedTimer fetch_timer;
 	// Queries for fetching object names from database
 	static const QString table_query;
 	static const QString sequence_query;
@@ -25,4 +57,18 @@ private:
 	static const QString view_query;
 	static const QString trigger_query;
 	static const QString index_query;
+	// Number of matches shown in the popup
+	static const int result_limit;
+	// Number of cached indexes
+	static const int index_cache_limit;
+	void SetIndex(const NameIndex &new_index);
+	void UpdateResults();
+	void CancelFetch();
+	bool PrepareIndexCache();
+signals:
+	void SchemaAccepted(const QString &schema);
+	void Fetched(int name_count, double milliseconds);
+	void FetchFailed(const QString &error_message);
+private slots:
+	void OnActivated(const QModelIndex &completion_index);
 };
\ No newline at end of file
@@ -1,80 +1,136 @@
 #include "PatchList.h"
 #include "PatchListElement.h"
-
-#include <QList>
-#include <QFile>
-#include <QTextStream>
-#include <algorithm>
+#include "StringPool.h"
 
 // Constructor
 PatchList::PatchList()
-	: elements(new QList<PatchListElement*>)
 {
 }
 
-// Copy constructor
-PatchList::PatchList(const PatchList &other)
-	: elements(new QList<PatchListElement*>)
+// Adds a new object to the list
+// Schema and parameters are interned in string pool, name is appended to text buffer
+void PatchList::Add(int type_index, const QString &schema_name, const QString &name, const QStringList &parameters)
 {
-	for (const auto current : *other.elements)
+	types.append(static_cast<quint8>(type_index));
+	schemas.append(StringPool::Intern(schema_name));
+	name_offsets.append(text.size());
+	name_lengths.append(name.size());
+	parameter_starts.append(this->parameters.count());
+	text.append(name);
+
+	for (const auto &current : parameters)
 	{
-		elements->append(new PatchListElement(*current));
+		this->parameters.append(StringPool::Intern(current));
 	}
 }
 
-// Assignment operator
-PatchList& PatchList::operator=(const PatchList &other)
+// Reserves space for the given amount of objects
+void PatchList::Reserve(int size)
 {
-	if (this != &other)
-	{
-		PatchList(other).Swap(*this);
-	}
-	return *this;
+	types.reserve(size);
+	schemas.reserve(size);
+	name_offsets.reserve(size);
+	name_lengths.reserve(size);
+	parameter_starts.reserve(size);
 }
 
-// Swap method used in assignment operator implementation
-void PatchList::Swap(PatchList &other)
+// Returns amount of objects in the list
+int PatchList::Count() const
 {
-	std::swap(elements, other.elements);
+	return types.count();
 }
 
-// Adds a new object to the list
-void PatchList::Add(int type_index, const QString &schema_name, const QString &name, const QStringList &parameters)
-{	
-	elements->append(new PatchListElement(type_index, name, schema_name, parameters));
+// Returns object by its index
+PatchListElement PatchList::At(int index) const
+{
+	return PatchListElement(*this, index);
 }
 
-// Returns amount of objects in the list
-int PatchList::Count() const
+// Getter for object type
+int PatchList::GetType(int index) const
+{
+	return types.at(index);
+}
+
+// Getter for object schema
+QString PatchList::GetSchema(int index) const
 {
-	return elements->count();
+	return StringPool::Value(schemas.at(index));
+}
+
+// Getter for object name
+QString PatchList::GetName(int index) const
+{
+	return text.mid(name_offsets.at(index), name_lengths.at(index));
+}
+
+// Getter for object parameters
+QStringList PatchList::GetParameters(int index) const
+{
+	QStringList result;
+	const auto first = parameter_starts.at(index);
+	const auto count = ParameterCount(index);
+
+	for (auto i = first; i < first + count; ++i)
+	{
+		result.append(StringPool::Value(parameters.at(i)));
+	}
+
+	return result;
 }
 
 // Iterators used in range-based 'for' loop
-QList<class PatchListElement*>::const_iterator PatchList::begin() const
+PatchList::ConstIterator PatchList::begin() const
 {
-	return elements->constBegin();
+	return ConstIterator(this, 0);
 }
 
-QList<class PatchListElement*>::const_iterator PatchList::end() const
+PatchList::ConstIterator PatchList::end() const
 {
-	return elements->constEnd();
+	return ConstIterator(this, Count());
 }
 
 // Clears the list
 void PatchList::Clear()
 {
-	for (const auto current : *elements)
-	{
-		delete current;
-	}
+	types.clear();
+	schemas.clear();
+	name_offsets.clear();
+	name_lengths.clear();
+	parameter_starts.clear();
+	parameters.clear();
+	text.clear();
+}
+
+// Returns amount of parameters of object
+int PatchList::ParameterCount(int index) const
+{
+	const auto next_start = index + 1 < parameter_starts.count() ? parameter_starts.at(index + 1) : parameters.count();
+	return next_start - parameter_starts.at(index);
+}
+
+// Iterator constructor
+PatchList::ConstIterator::ConstIterator(const PatchList *list, int index)
+	: list(list)
+	, index(index)
+{
+}
 
-	elements->clear();
+// Returns current element
+PatchListElement PatchList::ConstIterator::operator*() const
+{
+	return PatchListElement(*list, index);
+}
+
+// Moves to the next element
+PatchList::ConstIterator& PatchList::ConstIterator::operator++()
+{
+	++index;
+	return *this;
 }
 
-// Destructor
-PatchList::~PatchList()
+// Compares iterator positions
+bool PatchList::ConstIterator::operator!=(const ConstIterator &other) const
 {
-	Clear();
-	delete elements;
+	return index != other.index || list != other.list;
 }
\ No newline at end of file
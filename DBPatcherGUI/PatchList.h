@@ -1,24 +1,62 @@
 #pragma once
 
-#include <QList>
+#include <QStringList>
+#include <QVector>
 
 class PatchListElement;
 
 // Class implementing list of database objects
+// Objects are stored column by column in contiguous arrays: types as bytes, schemas and parameters as string pool handles,
+// names as ranges of one shared text buffer, so adding an object allocates nothing per object.
+// Arrays are implicitly shared, so copying the list is cheap and the data is copied only when a copy is changed
 class PatchList
 {
 public:
+
+	// Iterator used in range-based 'for' loop, gives elements by value
+	class ConstIterator
+	{
+	public:
+		ConstIterator(const PatchList *list, int index);
+		PatchListElement operator*() const;
+		ConstIterator& operator++();
+		bool operator!=(const ConstIterator &other) const;
+	private:
+		// Iterated list
+		const PatchList *list;
+		// Index of current element
+		int index;
+	};
+
 	PatchList();
-	~PatchList();
-	PatchList(const PatchList &other);
-	PatchList& operator=(const PatchList &other);
+	PatchList(const PatchList &other) = default;
+	PatchList(PatchList &&other) noexcept = default;
+	PatchList& operator=(const PatchList &other) = default;
+	PatchList& operator=(PatchList &&other) noexcept = default;
 	void Add(int type_index, const QString &schema_name, const QString &name, const QStringList &parameters = {});
+	void Reserve(int size);
 	int Count() const;
-	QList<PatchListElement*>::const_iterator begin() const;
-	QList<PatchListElement*>::const_iterator end() const;
+	PatchListElement At(int index) const;
+	int GetType(int index) const;
+	QString GetSchema(int index) const;
+	QString GetName(int index) const;
+	QStringList GetParameters(int index) const;
+	ConstIterator begin() const;
+	ConstIterator end() const;
 	void Clear();
 private:
-	void Swap(PatchList &other);
-	// Internal storage of database objects
-	QList<PatchListElement*> *elements;
+	// Type index of each object
+	QVector<quint8> types;
+	// String pool handle of schema name of each object
+	QVector<int> schemas;
+	// Position and length of name of each object in text buffer
+	QVector<int> name_offsets;
+	QVector<int> name_lengths;
+	// Index of the first parameter of each object in parameters
+	QVector<int> parameter_starts;
+	// String pool handles of parameters of all objects
+	QVector<int> parameters;
+	// Names of all objects
+	QString text;
+	int ParameterCount(int index) const;
 };
\ No newline at end of file
@@ -1,35 +1,33 @@
 #include "PatchListElement.h"
+#include "PatchList.h"
 
 // Constructor
-PatchListElement::PatchListElement(int type, const QString &name, const QString &schema
-	, const QStringList &parameters)
-	: type(type)
-	, name(name)
-	, schema(schema)
-	, parameters(parameters)
+PatchListElement::PatchListElement(const PatchList &list, int index)
+	: list(&list)
+	, index(index)
 {
 }
 
 // Getter for type
 int PatchListElement::GetType() const
 {
-	return type;
+	return list->GetType(index);
 }
 
 // Getter for name
 QString PatchListElement::GetName() const
 {
-	return name;
+	return list->GetName(index);
 }
 
 // Getter for schema
 QString PatchListElement::GetSchema() const
 {
-	return schema;
+	return list->GetSchema(index);
 }
 
 // Getter for parameters
 QStringList PatchListElement::GetParameters() const
 {
-	return parameters;
+	return list->GetParameters(index);
 }
\ No newline at end of file
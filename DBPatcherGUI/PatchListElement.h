@@ -2,24 +2,21 @@
 
 #include <QStringList>
 
-class QString;
+class PatchList;
 
 // Database object class
+// Light view of an object stored in PatchList, valid while the list is alive and not changed
 class PatchListElement
 {
 public:
-	PatchListElement(int type, const QString &name, const QString &schema, const QStringList &parameters);
+	PatchListElement(const PatchList &list, int index);
 	int GetType() const;
 	QString GetName() const;
 	QString GetSchema() const;
 	QStringList GetParameters() const;
 private:
-	// Type index
-	int type;
-	// Object name
-	QString name;
-	// Object schema
-	QString schema;
-	// List of object parameters
-	QStringList parameters;
+	// List which stores the object
+	const PatchList *list;
+	// Index of the object in the list
+	int index;
 };
\ No newline at end of file
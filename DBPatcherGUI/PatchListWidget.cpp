@@ -1,70 +1,144 @@
 #include "PatchListWidget.h"
-#include "ObjectTypes.h"
+#include "ObjectListModel.h"
+#include "PatchList.h"
+#include "MappedListFile.h"
 
 #include <QDropEvent>
 
 // Constructor
 PatchListWidget::PatchListWidget(QWidget* parent)
-	: QTreeWidget(parent)
+	: QTreeView(parent)
+	, model(new ObjectListModel(false, this))
 {
-	setColumnCount(3);
-	QStringList header_labels;
-	header_labels.insert(type_column, "Type");
-	header_labels.insert(schema_column, "Schema");
-	header_labels.insert(name_column, "Name");
-	setHeaderLabels(header_labels);
+	setModel(model);
 	setRootIsDecorated(false);
+	setUniformRowHeights(true);
 	setSelectionMode(SingleSelection);
 	setDragEnabled(true);
 	viewport()->setAcceptDrops(true);
 	setDropIndicatorShown(true);
 	setDragDropMode(InternalMove);
+
+	connect(selectionModel(), &QItemSelectionModel::selectionChanged, this, &PatchListWidget::SelectionChanged);
+	connect(model, &ObjectListModel::SourceLineInvalid, this, &PatchListWidget::LineInvalid);
 }
 
 // Checks object for existence in the list
-bool PatchListWidget::ItemExists(int type_index, const class QString& schema, const class QString& name)
+bool PatchListWidget::ItemExists(int type_index, const QString &schema, const QString &name)
+{
+	return model->Contains(type_index, schema, name);
+}
+
+// Adds a new object to list
+void PatchListWidget::Add(int type_index, const QString &schema, const QString &name, bool is_draggable)
 {
-	const auto found_items = findItems(name, Qt::MatchFixedString, name_column);
+	model->Add(type_index, schema, name, is_draggable);
+	scrollTo(model->index(model->rowCount() - 1, 0));
+}
 
-	for (const auto current : found_items)
+// Adds a batch of objects to list with one update
+void PatchListWidget::Add(const PatchList &objects, bool is_draggable)
+{
+	if (objects.Count() == 0)
 	{
-		if (current->text(type_column) == ObjectTypes::type_names.value(type_index) && current->text(schema_column) ==
-			schema)
-		{
-			return true;
-		}
+		return;
 	}
 
-	return false;
+	model->Add(objects, is_draggable);
+	scrollTo(model->index(model->rowCount() - 1, 0));
 }
 
-// Adds a new object to list
-void PatchListWidget::Add(int type_index, const class QString& schema, const class QString& name, bool is_draggable)
+// Removes object from list
+void PatchListWidget::Remove(int row)
 {
-	auto* new_item = new QTreeWidgetItem(this);
-
-	new_item->setIcon(type_column, QIcon(ObjectTypes::type_icons.value(type_index)));
-	new_item->setText(type_column, ObjectTypes::type_names.value(type_index));
-	new_item->setData(type_column, Qt::UserRole, type_index);
-	new_item->setText(schema_column, schema);
-	new_item->setText(name_column, name);
+	model->Remove(row);
+}
 
-	if (is_draggable)
+// Moves object to another position and makes it current
+void PatchListWidget::Move(int from_row, int to_row)
+{
+	if (model->Move(from_row, to_row))
 	{
-		new_item->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemIsDragEnabled);
+		setCurrentIndex(model->index(to_row, 0));
 	}
-	else
+}
+
+// Clears list
+void PatchListWidget::Clear()
+{
+	model->Clear();
+}
+
+// Shows object list file without keeping parsed objects, lines are decoded as they are shown
+bool PatchListWidget::OpenMapped(const QString &path, QString &error_message)
+{
+	std::unique_ptr<MappedListFile> file(new MappedListFile(ListFileParser::object_list_format));
+
+	if (!file->Open(path, error_message))
 	{
-		new_item->setFlags(Qt::ItemIsEnabled);
+		return false;
 	}
 
-	addTopLevelItem(new_item);
-	scrollToItem(new_item);
+	model->SetSource(std::move(file));
+	return true;
+}
+
+// Checks if list shows mapped file
+bool PatchListWidget::IsMapped() const
+{
+	return model->IsMapped();
+}
+
+// Returns amount of objects in list
+int PatchListWidget::Count() const
+{
+	return model->rowCount();
+}
+
+// Returns index of current object or -1 if there is no one
+int PatchListWidget::CurrentRow() const
+{
+	return currentIndex().row();
+}
+
+// Returns name of object by its index
+QString PatchListWidget::GetName(int row) const
+{
+	return model->GetName(row);
+}
+
+// Returns objects of the list in list order, mapped file keeps order of its lines
+PatchList PatchListWidget::GetObjects() const
+{
+	return model->GetObjects();
 }
 
 // Handles drop of dragged object
+// Dragged row is moved by the model, the view does not remove it after drop because the model does not remove rows
 void PatchListWidget::dropEvent(QDropEvent* event)
 {
-	QTreeWidget::dropEvent(event);
-	setCurrentItem(itemAt(event->pos()));
+	const auto from_row = CurrentRow();
+
+	if (event->source() != this || from_row < 0)
+	{
+		event->ignore();
+		return;
+	}
+
+	const auto target_index = indexAt(event->pos());
+	auto to_row = model->rowCount() - 1;
+
+	if (target_index.isValid())
+	{
+		to_row = dropIndicatorPosition() == BelowItem ? target_index.row() + 1 : target_index.row();
+
+		// Rows below the dragged one are shifted up when it is taken out
+		if (to_row > from_row)
+		{
+			--to_row;
+		}
+	}
+
+	Move(from_row, to_row);
+	event->acceptProposedAction();
 }
\ No newline at end of file
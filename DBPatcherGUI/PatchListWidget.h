@@ -1,24 +1,35 @@
 #pragma once
 
-#include <QTreeWidget>
+#include <QTreeView>
+
+class ObjectListModel;
+class PatchList;
 
 // Class implementing graphical interface for list of patch objects
-class PatchListWidget : public QTreeWidget
+// Objects are kept in table model, the view creates nothing per object and draws only visible rows
+class PatchListWidget : public QTreeView
 {
 	Q_OBJECT
 
 public:
-
-	enum ColumnIndexes
-	{
-		type_column,
-		schema_column,
-		name_column
-	};
-
 	PatchListWidget(QWidget *parent = nullptr);
 	bool ItemExists(int type_index, const QString &schema, const QString &name);
 	void Add(int type_index, const QString &schema, const QString &name, bool is_draggable);
+	void Add(const PatchList &objects, bool is_draggable);
+	void Remove(int row);
+	void Move(int from_row, int to_row);
+	void Clear();
+	bool OpenMapped(const QString &path, QString &error_message);
+	bool IsMapped() const;
+	int Count() const;
+	int CurrentRow() const;
+	QString GetName(int row) const;
+	PatchList GetObjects() const;
 private:
+	// Model of patch objects
+	ObjectListModel *model;
 	void dropEvent(QDropEvent *event) override;
+signals:
+	void SelectionChanged();
+	void LineInvalid(const QString &error_message);
 };
\ No newline at end of file
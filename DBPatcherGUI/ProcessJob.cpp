@@ -0,0 +1,222 @@
+#include "ProcessJob.h"
+
+#include <QTimer>
+
+const int ProcessJob::progress_interval = 500;
+
+// Constructor
+ProcessJob::ProcessJob(const QString &program, const QStringList &arguments, QObject *parent)
+	: QObject(parent)
+	, process(new QProcess(this))
+	, program(program)
+	, arguments(arguments)
+	, progress_timer(new QTimer(this))
+	, timeout_timer(new QTimer(this))
+	, output_line_count(0)
+	, status(not_started)
+	, timeout(0)
+	, is_output_streamed(false)
+	, is_output_framed(false)
+{
+	progress_timer->setInterval(progress_interval);
+	timeout_timer->setSingleShot(true);
+
+	connect(process, &QProcess::readyReadStandardOutput, this, [this]()
+	{
+		ReadStandardOutput(process->readAllStandardOutput());
+	});
+
+	connect(process, &QProcess::readyReadStandardError, this, [this]()
+	{
+		ReadOutput(process->readAllStandardError());
+	});
+
+	connect(progress_timer, &QTimer::timeout, this, [this]()
+	{
+		emit Progress(output_line_count, elapsed_timer.elapsed());
+	});
+
+	connect(timeout_timer, &QTimer::timeout, this, [this]()
+	{
+		if (IsRunning())
+		{
+			status = timed_out;
+			process->kill();
+		}
+	});
+
+	connect(process, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished), this, &ProcessJob::OnProcessFinished);
+	connect(process, &QProcess::errorOccurred, this, &ProcessJob::OnProcessError);
+}
+
+// Destructor, kills process if it is still running
+ProcessJob::~ProcessJob()
+{
+	process->disconnect(this);
+
+	if (IsRunning())
+	{
+		process->kill();
+		process->waitForFinished();
+	}
+}
+
+// Sets process time limit in milliseconds, 0 means no limit
+// Process which is not finished in time is killed
+void ProcessJob::SetTimeout(int milliseconds)
+{
+	timeout = qMax(0, milliseconds);
+}
+
+// Sets if standard output is passed on by StandardOutputReceived signal as it comes instead of OutputReceived one
+// So the owner consumes results of process while it is running, error output is passed on as log in both cases
+void ProcessJob::SetOutputStreamed(bool is_streamed)
+{
+	is_output_streamed = is_streamed;
+}
+
+// Sets if standard output is passed on by complete lines with LineReceived signal instead of OutputReceived one
+// Lines are assembled across chunks, the last line is passed on when the process is finished
+void ProcessJob::SetOutputFramed(bool is_framed)
+{
+	is_output_framed = is_framed;
+}
+
+// Launches process
+void ProcessJob::Start()
+{
+	output_line_count = 0;
+	output_framer.Clear();
+	status = running;
+	elapsed_timer.start();
+	progress_timer->start();
+
+	if (timeout > 0)
+	{
+		timeout_timer->start(timeout);
+	}
+
+	process->start(program, arguments);
+}
+
+// Cancels job, killing its process
+// Finished signal reports unsuccessful result when the process is stopped
+void ProcessJob::Cancel()
+{
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	status = cancelled;
+	process->kill();
+}
+
+// Checks if process is started and not finished yet
+bool ProcessJob::IsRunning() const
+{
+	return process->state() != QProcess::NotRunning;
+}
+
+// Returns current status of job
+ProcessJob::Status ProcessJob::GetStatus() const
+{
+	return status;
+}
+
+// Returns exit code of finished process
+int ProcessJob::GetExitCode() const
+{
+	return process->exitCode();
+}
+
+// Counts output lines and passes output on
+void ProcessJob::ReadOutput(const QByteArray &output)
+{
+	if (output.isEmpty())
+	{
+		return;
+	}
+
+	output_line_count += output.count('\n');
+	emit OutputReceived(output);
+	emit Progress(output_line_count, elapsed_timer.elapsed());
+}
+
+// Streams, frames or passes on chunk of standard output
+void ProcessJob::ReadStandardOutput(const QByteArray &output)
+{
+	if (is_output_streamed)
+	{
+		if (!output.isEmpty())
+		{
+			emit StandardOutputReceived(output);
+		}
+	}
+	else if (is_output_framed)
+	{
+		for (const auto &line : output_framer.Append(output))
+		{
+			emit LineReceived(line);
+		}
+	}
+	else
+	{
+		ReadOutput(output);
+	}
+}
+
+// Stops progress reports and reports result
+void ProcessJob::Finish(Status final_status, const QString &error_message)
+{
+	progress_timer->stop();
+	timeout_timer->stop();
+	status = final_status;
+	emit Finished(status == succeeded, error_message);
+}
+
+// Handles process finish
+// Status set by cancellation or timeout is kept, as the process is killed then
+void ProcessJob::OnProcessFinished(int exit_code, QProcess::ExitStatus exit_status)
+{
+	// Output which is not read yet and the last line without line break are passed on before the result
+	ReadStandardOutput(process->readAllStandardOutput());
+	ReadOutput(process->readAllStandardError());
+	const auto last_line = output_framer.TakeRest();
+
+	if (is_output_framed && !last_line.isEmpty())
+	{
+		emit LineReceived(last_line);
+	}
+
+	if (status == cancelled)
+	{
+		Finish(cancelled, "Cancelled by user");
+	}
+	else if (status == timed_out)
+	{
+		Finish(timed_out, QString("%1 is stopped after timeout of %2 s").arg(program).arg(timeout / 1000.0));
+	}
+	else if (exit_status == QProcess::CrashExit)
+	{
+		Finish(crashed, program + " crashed");
+	}
+	else if (exit_code != 0)
+	{
+		Finish(exited_with_error, QString("%1 finished with exit code %2").arg(program).arg(exit_code));
+	}
+	else
+	{
+		Finish(succeeded, "");
+	}
+}
+
+// Handles process errors
+// Only start failure is reported here, as after other errors the process finishes and its result is reported then
+void ProcessJob::OnProcessError(QProcess::ProcessError error)
+{
+	if (error == QProcess::FailedToStart)
+	{
+		Finish(failed_to_start, program + " is not started: " + process->errorString());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "LineFramer.h"
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QProcess>
+#include <QStringList>
+
+class QTimer;
+
+// Class implementing asynchronous run of external module process
+// Process is not waited for, its output, progress and result are reported by signals, so the interface stays responsive.
+// Job has no time limit unless it is set, and can be cancelled. It is started by the owner after signals are connected
+class ProcessJob : public QObject
+{
+	Q_OBJECT
+
+public:
+	// Final status of job, showing why it is finished
+	enum Status
+	{
+		not_started,
+		running,
+		succeeded,
+		failed_to_start,
+		crashed,
+		exited_with_error,
+		timed_out,
+		cancelled
+	};
+	Q_ENUM(Status)
+
+	ProcessJob(const QString &program, const QStringList &arguments, QObject *parent = nullptr);
+	~ProcessJob();
+	void SetTimeout(int milliseconds);
+	void SetOutputStreamed(bool is_streamed);
+	void SetOutputFramed(bool is_framed);
+	void Start();
+	void Cancel();
+	bool IsRunning() const;
+	Status GetStatus() const;
+	int GetExitCode() const;
+private:
+	// Module process
+	QProcess *process;
+	// Program and its arguments
+	QString program;
+	QStringList arguments;
+	// Timer reporting progress while there is no output
+	QTimer *progress_timer;
+	// Timer stopping process which runs longer than timeout
+	QTimer *timeout_timer;
+	// Time since the start
+	QElapsedTimer elapsed_timer;
+	// Amount of output lines received
+	int output_line_count;
+	// Current status of job
+	Status status;
+	// Process time limit in milliseconds, 0 if it is unlimited
+	int timeout;
+	// Flag showing if standard output is passed on to the owner only, as it is not a log
+	bool is_output_streamed;
+	// Flag showing if standard output is passed on by lines
+	bool is_output_framed;
+	// Assembler of standard output lines
+	LineFramer output_framer;
+	// Interval of progress reports in milliseconds
+	static const int progress_interval;
+	void ReadOutput(const QByteArray &output);
+	void ReadStandardOutput(const QByteArray &output);
+	void Finish(Status final_status, const QString &error_message);
+signals:
+	void OutputReceived(const QByteArray &output);
+	void LineReceived(const QByteArray &line);
+	void StandardOutputReceived(const QByteArray &output);
+	void Progress(int output_line_count, qint64 elapsed_time);
+	void Finished(bool is_successful, const QString &error_message);
+private slots:
+	void OnProcessFinished(int exit_code, QProcess::ExitStatus exit_status);
+	void OnProcessError(QProcess::ProcessError error);
+};
\ No newline at end of file
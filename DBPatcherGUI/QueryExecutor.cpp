@@ -0,0 +1,296 @@
+#include "QueryExecutor.h"
+#include "FunctionTask.h"
+
+#include <QMutexLocker>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QThread>
+#include <QThreadPool>
+#include <QVariant>
+
+int QueryExecutor::last_job_id = 0;
+int QueryExecutor::executor_count = 0;
+QAtomicInt QueryExecutor::cancel_count = 0;
+const int QueryExecutor::health_check_interval = 5000;
+
+// Constructor, starts worker thread
+// Worker connection is opened with the first job, so construction does not wait for the network
+QueryExecutor::QueryExecutor(const QString &database, const QString &user, const QString &password,
+	const QString &server, int port, QObject *parent)
+	: QObject(parent)
+	, worker(new QObject)
+	, thread(new QThread(this))
+	, connection_name(QString("query_executor_%1").arg(++executor_count))
+	, database(database)
+	, user(user)
+	, password(password)
+	, server(server)
+	, port(port)
+	, backend_pid(0)
+	, running_job(0)
+	, cancelled_up_to(0)
+	, cancel_state(std::make_shared<CancelState>())
+{
+	idle_timer.start();
+	worker->moveToThread(thread);
+
+	// finished() is emitted in the worker thread, so the connection is removed in the thread which owns it
+	const auto name = connection_name;
+	connect(thread, &QThread::finished, worker, [name]()
+	{
+		if (QSqlDatabase::contains(name))
+		{
+			QSqlDatabase::database(name, false).close();
+			QSqlDatabase::removeDatabase(name);
+		}
+	}, Qt::DirectConnection);
+
+	thread->start();
+}
+
+// Destructor, cancels all jobs and waits for the worker thread
+QueryExecutor::~QueryExecutor()
+{
+	CancelAll();
+	thread->quit();
+	thread->wait();
+	delete worker;
+}
+
+// Cancels a job
+// Waiting job is skipped, running query is cancelled on server side
+void QueryExecutor::Cancel(int job_id)
+{
+	if (!pending_jobs.contains(job_id))
+	{
+		return;
+	}
+
+	auto pid = 0;
+
+	{
+		QMutexLocker locker(&mutex);
+		cancelled_jobs.insert(job_id);
+		pid = running_job == job_id ? BeginCancel() : 0;
+	}
+
+	CancelRunningQuery(pid);
+}
+
+// Cancels all submitted jobs
+void QueryExecutor::CancelAll()
+{
+	auto pid = 0;
+
+	{
+		QMutexLocker locker(&mutex);
+		cancelled_up_to = last_job_id;
+		pid = running_job != 0 ? BeginCancel() : 0;
+	}
+
+	CancelRunningQuery(pid);
+}
+
+// Opens worker connection in advance, so the first job does not wait for it
+void QueryExecutor::Open()
+{
+	QMetaObject::invokeMethod(worker, [this]()
+	{
+		Connection();
+	}, Qt::QueuedConnection);
+}
+
+// Returns number of submitted jobs whose callbacks are not called yet
+int QueryExecutor::PendingCount() const
+{
+	return pending_jobs.count();
+}
+
+// Returns time in milliseconds since the executor had the last job, 0 if it has pending jobs
+qint64 QueryExecutor::IdleTime() const
+{
+	return pending_jobs.isEmpty() ? idle_timer.elapsed() : 0;
+}
+
+// Posts a job to the worker thread
+int QueryExecutor::Enqueue(const std::function<void(QSqlDatabase&)> &job, QObject *context, const std::function<void()> &on_finished)
+{
+	const auto job_id = ++last_job_id;
+	const QPointer<QObject> guarded_context(context);
+	pending_jobs.insert(job_id);
+	idle_timer.restart();
+
+	QMetaObject::invokeMethod(worker, [=]()
+	{
+		Run(job_id, job, guarded_context, on_finished);
+	}, Qt::QueuedConnection);
+
+	return job_id;
+}
+
+// Runs a job in the worker thread and posts its callback to the owner thread
+void QueryExecutor::Run(int job_id, const std::function<void(QSqlDatabase&)> &job, const QPointer<QObject> &context
+	, const std::function<void()> &on_finished)
+{
+	auto is_skipped = false;
+
+	WaitForCancels();
+
+	{
+		QMutexLocker locker(&mutex);
+		is_skipped = IsCancelled(job_id);
+		running_job = is_skipped ? 0 : job_id;
+	}
+
+	if (!is_skipped)
+	{
+		auto connection = Connection();
+		job(connection);
+		connection_idle_timer.restart();
+
+		QMutexLocker locker(&mutex);
+		running_job = 0;
+	}
+
+	// Callback and context are checked in the owner thread, where they can be changed
+	QMetaObject::invokeMethod(this, [=]()
+	{
+		pending_jobs.remove(job_id);
+		idle_timer.restart();
+		auto is_cancelled = false;
+
+		{
+			QMutexLocker locker(&mutex);
+			is_cancelled = IsCancelled(job_id);
+			cancelled_jobs.remove(job_id);
+		}
+
+		if (!is_cancelled && context)
+		{
+			on_finished();
+		}
+	}, Qt::QueuedConnection);
+}
+
+// Checks if job is cancelled, must be called with locked mutex
+bool QueryExecutor::IsCancelled(int job_id) const
+{
+	return job_id <= cancelled_up_to || cancelled_jobs.contains(job_id);
+}
+
+// Registers cancellation of the running query, must be called with locked mutex
+// Worker waits for registered cancellations before the next job, so only the query of the running job is cancelled
+// Returns backend process id to pass to CancelRunningQuery, 0 if there is no query to cancel
+int QueryExecutor::BeginCancel()
+{
+	const auto pid = backend_pid.load();
+
+	if (pid != 0)
+	{
+		QMutexLocker locker(&cancel_state->mutex);
+		++cancel_state->running_count;
+	}
+
+	return pid;
+}
+
+// Sends cancellation registered by BeginCancel from a thread pool by a separate connection
+// Neither the owner thread nor the executor mutex waits for the server
+void QueryExecutor::CancelRunningQuery(int pid)
+{
+	if (pid == 0)
+	{
+		return;
+	}
+
+	const auto state = cancel_state;
+	const auto name = QString("query_cancel_%1").arg(++cancel_count);
+	const auto database = this->database;
+	const auto user = this->user;
+	const auto password = this->password;
+	const auto server = this->server;
+	const auto port = this->port;
+
+	QThreadPool::globalInstance()->start(new FunctionTask([=]()
+	{
+		{
+			auto connection = QSqlDatabase::addDatabase("QPSQL", name);
+			connection.setDatabaseName(database);
+			connection.setUserName(user);
+			connection.setPassword(password);
+			connection.setHostName(server);
+			connection.setPort(port);
+
+			if (connection.open())
+			{
+				QSqlQuery cancel(connection);
+				cancel.prepare("SELECT pg_cancel_backend(?);");
+				cancel.addBindValue(pid);
+				cancel.exec();
+			}
+
+			connection.close();
+		}
+
+		QSqlDatabase::removeDatabase(name);
+
+		QMutexLocker locker(&state->mutex);
+		--state->running_count;
+		state->finished.wakeAll();
+	}));
+}
+
+// Waits until cancellations of the previous query are sent, so they can not hit the next one
+// Must be called in the worker thread
+void QueryExecutor::WaitForCancels()
+{
+	QMutexLocker locker(&cancel_state->mutex);
+
+	while (cancel_state->running_count > 0)
+	{
+		cancel_state->finished.wait(&cancel_state->mutex);
+	}
+}
+
+// Returns worker connection, opening it if needed
+// Connection which was idle for a while is checked first and reopened if server has dropped it
+// Must be called in the worker thread
+QSqlDatabase QueryExecutor::Connection()
+{
+	auto connection = QSqlDatabase::contains(connection_name) ? QSqlDatabase::database(connection_name, false)
+		: QSqlDatabase::addDatabase("QPSQL", connection_name);
+
+	if (connection.isOpen() && connection_idle_timer.isValid() && connection_idle_timer.elapsed() >= health_check_interval)
+	{
+		QSqlQuery check(connection);
+
+		if (!check.exec("SELECT 1;"))
+		{
+			connection.close();
+		}
+	}
+
+	connection_idle_timer.start();
+
+	if (!connection.isOpen())
+	{
+		connection.setDatabaseName(database);
+		connection.setUserName(user);
+		connection.setPassword(password);
+		connection.setHostName(server);
+		connection.setPort(port);
+		backend_pid.store(0);
+
+		if (connection.open())
+		{
+			QSqlQuery fetch("SELECT pg_backend_pid();", connection);
+
+			if (fetch.next())
+			{
+				backend_pid.store(fetch.value(0).toInt());
+			}
+		}
+	}
+
+	return connection;
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <QObject>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QPointer>
+#include <QSet>
+#include <QString>
+#include <QWaitCondition>
+#include <functional>
+#include <memory>
+#include <utility>
+
+class QSqlDatabase;
+class QThread;
+
+// Class running database jobs in a worker thread with its own connection
+// QSqlDatabase connections can be used only in the thread which created them, so the worker opens its own one
+// Job results are passed to callbacks in the thread which owns the executor
+class QueryExecutor : public QObject
+{
+	Q_OBJECT
+
+public:
+	QueryExecutor(const QString &database, const QString &user, const QString &password,
+		const QString &server, int port, QObject *parent = nullptr);
+	~QueryExecutor();
+	template <typename Job, typename Callback>
+	int Submit(Job job, QObject *context, Callback on_finished);
+	void Cancel(int job_id);
+	void CancelAll();
+	void Open();
+	int PendingCount() const;
+	qint64 IdleTime() const;
+private:
+	// Query cancellations sent by separate connections
+	// Shared with the tasks sending them, so they can finish after the executor is deleted
+	struct CancelState
+	{
+		QMutex mutex;
+		QWaitCondition finished;
+		// Amount of cancellations not sent yet
+		int running_count = 0;
+	};
+
+	// Object living in the worker thread, jobs are posted to it
+	QObject *worker;
+	// Worker thread
+	QThread *thread;
+	// Name and parameters of the worker connection
+	QString connection_name;
+	QString database;
+	QString user;
+	QString password;
+	QString server;
+	int port;
+	// Backend process id of the worker connection, used to cancel running query
+	QAtomicInt backend_pid;
+	// Id of the job running in the worker thread, 0 if there is no one
+	int running_job;
+	// Ids of submitted jobs whose callbacks are not called yet, used only in the owner thread
+	QSet<int> pending_jobs;
+	// Ids of cancelled pending jobs
+	QSet<int> cancelled_jobs;
+	// All jobs with not greater ids are cancelled
+	int cancelled_up_to;
+	// Mutex guarding running job id and cancelled job ids
+	QMutex mutex;
+	// Cancellations of running queries, worker waits for them before the next job
+	std::shared_ptr<CancelState> cancel_state;
+	// Time since the last job was submitted or finished, used only in the owner thread
+	QElapsedTimer idle_timer;
+	// Time since the worker connection was used, used only in the worker thread
+	QElapsedTimer connection_idle_timer;
+	// Connection idle for longer time in milliseconds is checked before a job
+	static const int health_check_interval;
+	// Id of the last submitted job, unique for all executors
+	static int last_job_id;
+	// Counters used for unique connection names
+	static int executor_count;
+	static QAtomicInt cancel_count;
+	int Enqueue(const std::function<void(QSqlDatabase&)> &job, QObject *context, const std::function<void()> &on_finished);
+	void Run(int job_id, const std::function<void(QSqlDatabase&)> &job, const QPointer<QObject> &context
+		, const std::function<void()> &on_finished);
+	bool IsCancelled(int job_id) const;
+	int BeginCancel();
+	void CancelRunningQuery(int pid);
+	void WaitForCancels();
+	QSqlDatabase Connection();
+};
+
+// Submits a job which takes worker connection and returns a result
+// on_finished is called with the result in the owner thread unless the job is cancelled or context is deleted
+// Returns id of the job which can be used for its cancellation
+template <typename Job, typename Callback>
+int QueryExecutor::Submit(Job job, QObject *context, Callback on_finished)
+{
+	using Result = decltype(job(std::declval<QSqlDatabase&>()));
+	const auto result = std::make_shared<Result>();
+
+	return Enqueue([job, result](QSqlDatabase &connection) mutable
+	{
+		*result = job(connection);
+	}, context, [on_finished, result]() mutable
+	{
+		on_finished(*result);
+	});
+}
\ No newline at end of file
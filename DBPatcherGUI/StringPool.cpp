@@ -0,0 +1,106 @@
+#include "StringPool.h"
+
+#include <QReadLocker>
+#include <QWriteLocker>
+
+QAtomicPointer<QString> StringPool::chunks[StringPool::max_chunk_count];
+QAtomicInt StringPool::count = 0;
+QHash<QString, int> StringPool::handles;
+QReadWriteLock StringPool::lock;
+QAtomicInteger<qint64> StringPool::requests = 0;
+QAtomicInteger<qint64> StringPool::bytes_saved = 0;
+
+// Returns handle of string, adding it to the pool if it is new
+// Known strings are found under shared lock, so threads interning them do not wait for each other
+int StringPool::Intern(const QString &value)
+{
+	requests.fetchAndAddRelaxed(1);
+
+	{
+		QReadLocker locker(&lock);
+		const auto found = handles.constFind(value);
+
+		if (found != handles.constEnd())
+		{
+			CountSaved(value, found.value());
+			return found.value();
+		}
+	}
+
+	QWriteLocker locker(&lock);
+	const auto found = handles.constFind(value);
+
+	if (found != handles.constEnd())
+	{
+		CountSaved(value, found.value());
+		return found.value();
+	}
+
+	const auto handle = count.load();
+	Q_ASSERT(handle < chunk_size * max_chunk_count);
+	auto chunk = chunks[handle / chunk_size].load();
+
+	if (!chunk)
+	{
+		chunk = new QString[chunk_size];
+		chunks[handle / chunk_size].storeRelease(chunk);
+	}
+
+	chunk[handle % chunk_size] = value;
+	handles.insert(value, handle);
+	count.storeRelease(handle + 1);
+	return handle;
+}
+
+// Returns handle of string or -1 if it is not in the pool
+// Lookups do not add strings, so checks of unknown names do not grow the pool
+int StringPool::Find(const QString &value)
+{
+	QReadLocker locker(&lock);
+	return handles.value(value, -1);
+}
+
+// Returns string by its handle, empty string for unknown handle
+// Returned string shares data with the pooled one, no lock is taken
+QString StringPool::Value(int handle)
+{
+	if (handle < 0 || handle >= count.loadAcquire())
+	{
+		return QString();
+	}
+
+	return StoredValue(handle);
+}
+
+// Returns amount of strings in the pool
+int StringPool::Count()
+{
+	return count.loadAcquire();
+}
+
+// Getter for requests
+qint64 StringPool::Requests()
+{
+	return requests.load();
+}
+
+// Getter for bytes_saved
+qint64 StringPool::BytesSaved()
+{
+	return bytes_saved.load();
+}
+
+// Returns stored string by handle which is known to be valid
+const QString& StringPool::StoredValue(int handle)
+{
+	return chunks[handle / chunk_size].loadAcquire()[handle % chunk_size];
+}
+
+// Counts data of requested string as saved unless it already shares data with the pooled one
+void StringPool::CountSaved(const QString &value, int handle)
+{
+	if (StoredValue(handle).constData() != value.constData())
+	{
+		bytes_saved.fetchAndAddRelaxed(value.size() * static_cast<qint64>(sizeof(QChar)));
+	}
+}
\ No newline at end of file
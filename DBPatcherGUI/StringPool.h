@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QAtomicInteger>
+#include <QAtomicPointer>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+
+// Class implementing process-wide pool of interned strings
+// Repeated names such as schemas and parameter types are stored once and referred to by integer handles,
+// which are stable for the whole run and compared as numbers. Pool is shared by threads:
+// strings are stored in append-only chunks which are never moved, so reading a string by handle takes no lock,
+// and only adding a new string locks the handle index for writing
+class StringPool
+{
+public:
+	static int Intern(const QString &value);
+	static int Find(const QString &value);
+	static QString Value(int handle);
+	static int Count();
+	static qint64 Requests();
+	static qint64 BytesSaved();
+private:
+	// Amount of strings in a chunk and upper limit of chunks
+	static const int chunk_size = 65536;
+	static const int max_chunk_count = 4096;
+	// Chunks of interned strings by handle, a chunk is allocated when the first string is added to it
+	static QAtomicPointer<QString> chunks[max_chunk_count];
+	// Amount of interned strings, it is increased after a string is stored, so readers see only stored strings
+	static QAtomicInt count;
+	// Handles by string
+	static QHash<QString, int> handles;
+	// Lock of handle index, readers of strings by handle do not take it
+	static QReadWriteLock lock;
+	// Amount of intern requests
+	static QAtomicInteger<qint64> requests;
+	// Size of string data which was not stored again because it was already in the pool
+	// Strings already sharing data with the pooled one are not counted, as they saved nothing
+	static QAtomicInteger<qint64> bytes_saved;
+	static const QString& StoredValue(int handle);
+	static void CountSaved(const QString &value, int handle);
+};
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "TrigramIndex.h"
+
+#include <QSet>
+#include <algorithm>
+
+// Constructor of empty index
+TrigramIndex::TrigramIndex()
+{
+}
+
+// Builds index over names, their order is kept for ranking of equal matches
+void TrigramIndex::Build(const QStringList &names)
+{
+	this->names = names;
+	folded_names.clear();
+	folded_names.reserve(names.count());
+	postings.clear();
+	match_counts.fill(0, names.count());
+
+	for (auto i = 0; i < names.count(); ++i)
+	{
+		const auto folded_name = names.at(i).toLower();
+		folded_names.append(folded_name);
+
+		for (auto position = 0; position + 3 <= folded_name.size(); ++position)
+		{
+			auto &posting = postings[Trigram(folded_name, position)];
+
+			// Repeated trigram of one name is stored once, so match counts are not inflated
+			if (posting.isEmpty() || posting.last() != i)
+			{
+				posting.append(i);
+			}
+		}
+	}
+}
+
+// Searches names matching pattern and returns indexes of at most limit best of them
+// Patterns shorter than a trigram are matched as substrings by scanning all names
+// Longer ones take names sharing at least half of pattern trigrams, so a typo does not hide the name
+QList<int> TrigramIndex::Search(const QString &pattern, int limit) const
+{
+	const auto folded_pattern = pattern.trimmed().toLower();
+	QVector<QPair<int, int>> candidates;
+
+	if (folded_pattern.size() < 3)
+	{
+		for (auto i = 0; i < folded_names.count(); ++i)
+		{
+			if (folded_names.at(i).contains(folded_pattern))
+			{
+				candidates.append(qMakePair(Score(folded_names.at(i), folded_pattern, 0, 0), i));
+			}
+		}
+	}
+	else
+	{
+		QSet<quint64> pattern_trigrams;
+
+		for (auto position = 0; position + 3 <= folded_pattern.size(); ++position)
+		{
+			pattern_trigrams.insert(Trigram(folded_pattern, position));
+		}
+
+		// Names without any of pattern trigrams are not touched
+		QVector<int> matched_names;
+
+		for (const auto trigram : pattern_trigrams)
+		{
+			for (const auto index : postings.value(trigram))
+			{
+				if (match_counts[index]++ == 0)
+				{
+					matched_names.append(index);
+				}
+			}
+		}
+
+		const auto threshold = (pattern_trigrams.count() + 1) / 2;
+
+		for (const auto index : matched_names)
+		{
+			if (match_counts.at(index) >= threshold)
+			{
+				candidates.append(qMakePair(Score(folded_names.at(index), folded_pattern, match_counts.at(index), pattern_trigrams.count()), index));
+			}
+
+			match_counts[index] = 0;
+		}
+	}
+
+	// Higher score goes first, then shorter name, then original order
+	const auto is_better = [this](const QPair<int, int> &left, const QPair<int, int> &right)
+	{
+		if (left.first != right.first)
+		{
+			return left.first > right.first;
+		}
+
+		if (names.at(left.second).size() != names.at(right.second).size())
+		{
+			return names.at(left.second).size() < names.at(right.second).size();
+		}
+
+		return left.second < right.second;
+	};
+
+	const auto result_count = qMin(qMax(0, limit), candidates.count());
+	std::partial_sort(candidates.begin(), candidates.begin() + result_count, candidates.end(), is_better);
+
+	QList<int> result;
+	result.reserve(result_count);
+
+	for (auto i = 0; i < result_count; ++i)
+	{
+		result.append(candidates.at(i).second);
+	}
+
+	return result;
+}
+
+// Returns indexed name by its index
+QString TrigramIndex::Name(int index) const
+{
+	return names.at(index);
+}
+
+// Returns number of indexed names
+int TrigramIndex::Count() const
+{
+	return names.count();
+}
+
+// Packs three characters starting from position into a key
+quint64 TrigramIndex::Trigram(const QString &text, int position)
+{
+	return (quint64(text.at(position).unicode()) << 32) | (quint64(text.at(position + 1).unicode()) << 16)
+		| quint64(text.at(position + 2).unicode());
+}
+
+// Scores a name against pattern
+// Exact match, prefix and substring matches go before fuzzy ones, which are ranked by share of matched trigrams
+int TrigramIndex::Score(const QString &folded_name, const QString &folded_pattern, int matched_trigrams, int pattern_trigrams)
+{
+	auto score = pattern_trigrams > 0 ? matched_trigrams * 100 / pattern_trigrams : 0;
+	const auto position = folded_name.indexOf(folded_pattern);
+
+	if (position < 0)
+	{
+		return score;
+	}
+
+	score += 1000;
+
+	if (position == 0)
+	{
+		score += folded_name.size() == folded_pattern.size() ? 2000 : 1000;
+	}
+	else if (!folded_name.at(position - 1).isLetterOrNumber())
+	{
+		// Match at a word start, like "user" in "get_user_name", is more likely what is meant
+		score += 500;
+	}
+
+	return score - qMin(position, 100);
+}
\ No newline at end of file
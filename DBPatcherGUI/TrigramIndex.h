@@ -0,0 +1,31 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// Class implementing in-memory trigram index over a list of names
+// Answers substring and fuzzy queries with a list of best matches ranked by score
+class TrigramIndex
+{
+public:
+	TrigramIndex();
+	void Build(const QStringList &names);
+	QList<int> Search(const QString &pattern, int limit) const;
+	QString Name(int index) const;
+	int Count() const;
+private:
+	// Indexed names
+	QStringList names;
+	// Lower case names used for matching
+	QStringList folded_names;
+	// Lists of name indexes for every trigram of their lower case names
+	QHash<quint64, QVector<int>> postings;
+	// Number of pattern trigrams found in every name, reused by searches
+	// Only entries touched by a search are reset after it, so a search does not cost a pass over all names
+	mutable QVector<int> match_counts;
+	static quint64 Trigram(const QString &text, int position);
+	static int Score(const QString &folded_name, const QString &folded_pattern, int matched_trigrams, int pattern_trigrams);
+};
\ No newline at end of file